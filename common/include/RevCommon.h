@@ -26,6 +26,10 @@
 #define _REV_INVALID_HART_ID_ (unsigned(~0))
 #endif
 
+#ifndef _REV_INVALID_CORE_ID_
+#define _REV_INVALID_CORE_ID_ (unsigned(~0))
+#endif
+
 #define _INVALID_ADDR_ (~uint64_t{0})
 
 #define _INVALID_TID_ (uint32_t{0})
@@ -90,13 +94,28 @@ constexpr uint64_t LSQHash(T DestReg, RevRegClass RegType, unsigned Hart){
   return static_cast<uint64_t>(RegType) << (16 + 8) | static_cast<uint64_t>(DestReg) << 16 | Hart;
 }
 
+struct MemReq;
+class RevRegFile;
+
+/// MemReqCompletion: trivially copyable completion handle carried by a
+/// MemReq.  Func is invoked with Owner when the request completes.
+struct MemReqCompletion{
+  void (*Func)(void *Owner, const MemReq& req) = nullptr;
+  void *Owner = nullptr;
+
+  /// MemReqCompletion: build a handle that invokes (Owner->*MemFn)(req)
+  template<typename T, void (T::*MemFn)(const MemReq&)>
+  static MemReqCompletion Bind(T *Owner){
+    return { [](void *O, const MemReq& req){ (static_cast<T*>(O)->*MemFn)(req); }, Owner };
+  }
+
+  void operator()(const MemReq& req) const { Func(Owner, req); }
+
+  explicit operator bool() const { return Func != nullptr; }
+};
+
 struct MemReq{
   MemReq() = default;
-  MemReq(const MemReq&) = default;
-  MemReq(MemReq&&) = default;
-  MemReq& operator=(const MemReq&) = default;
-  MemReq& operator=(MemReq&&) = default;
-  ~MemReq() = default;
 
   template<typename T>
   MemReq(uint64_t Addr,
@@ -105,14 +124,14 @@ struct MemReq{
          unsigned Hart,
          MemOp ReqType,
          bool isOutstanding,
-         std::function<void(const MemReq&)> MarkLoadCompleteFunc) :
+         MemReqCompletion MarkLoadCompleteFunc) :
     Addr(Addr),
     DestReg(uint16_t(DestReg)),
     RegType(RegType),
     Hart(Hart),
     ReqType(ReqType),
     isOutstanding(isOutstanding),
-    MarkLoadCompleteFunc(std::move(MarkLoadCompleteFunc)){}
+    MarkLoadCompleteFunc(MarkLoadCompleteFunc){}
 
   void MarkLoadComplete() const {
     MarkLoadCompleteFunc(*this);
@@ -133,23 +152,37 @@ struct MemReq{
   MemOp       ReqType       = MemOp::MemOpCUSTOM;
   bool        isOutstanding = false;
 
-  std::function<void(const MemReq&)> MarkLoadCompleteFunc = nullptr;
+  MemReqCompletion MarkLoadCompleteFunc{};
+
+  /// Register file of the thread that issued the load, set by
+  /// RevRegFile::LSQInsert.  The load completes into it even if the thread
+  /// has left the hart by then.
+  RevRegFile* RegFile = nullptr;
 
 };//struct MemReq
 
+// MemReq is copied into the LSQ, the prefetcher and every RevMemOp, so it
+// must remain cheap to copy
+static_assert(std::is_trivially_copyable_v<MemReq> && std::is_standard_layout_v<MemReq>,
+              "MemReq must be a trivially copyable, standard layout type");
+static_assert(sizeof(MemReq) <= 64, "MemReq must fit in a cache line");
+
 // Enum for tracking the state of a RevThread.
 // Ex. Possible flow of thread state:
 //    1)  New RevThread is created via rev_pthread_create (ThreadState::START)
 //    2)  The Proc that created the new thread puts it in its `ThreadsThatChangedState` queue
 //    3)  RevCPU sees there is a new thread in Procs[i]->ThreadsThatChangedState with status START
-//    4)  RevCPU changes thread's state to READY and moves it to ReadyThreads as it can be scheduled
-//    5)  Thread is scheduled on a Hart (ThreadState::RUNNING)
+//    4)  RevCPU changes thread's state to READY and queues it on the ReadyQueues entry of the
+//        core chosen by schedPolicy, as it can be scheduled
+//    5)  Thread is scheduled on a Hart of that core, or of an idle core that steals it
+//        (ThreadState::RUNNING)
 //    6)  Thread encounters a call to `rev_pthread_join` (ThreadState::BLOCKED)
 //    7)  The Proc that owns the RevHart the thread was executing on puts the blocked thread
 //        in its `ThreadsThatChangedState` queue
-//    8)  RevCPU sees there is a blocked thread and moves it to BlockedThreads
+//    8)  RevCPU sees there is a blocked thread and moves it to JoinWaiters (FutexQueues for
+//        FUTEX_WAIT)
 //    9)  Once the thread that the blocked thread is waiting on completes, it is
-//        moved back to ReadyThreads (ThreadState::READY)
+//        queued again on the ReadyQueues entry of its last core (ThreadState::READY)
 //    10) Thread is done (ie. PC = 0x0) so ensure there are no dependencies
 //    11) The Proc that owns the RevHart the thread was executing on puts the finished thread
 //        in its ThreadsThatChangedState queue (ThreadState::DONE)
@@ -157,7 +190,7 @@ struct MemReq{
 enum class ThreadState {
   START,    // Indicates this thread is new
   RUNNING,  // Thread is assigned and executing on a Proc/HART (NOTE: This does NOT change if a Thread is stalled)
-  BLOCKED,  // Waiting for thread synchronization at this point (Currently only triggered by call to `rev_pthread_join`)
+  BLOCKED,  // Waiting for thread synchronization at this point (`rev_pthread_join` or FUTEX_WAIT)
   READY,    // Indicates this thread is ready to be scheduled
   DONE,     // Thread has finished; deallocate resources.
 };
@@ -312,8 +312,8 @@ struct io_event {
 
 struct iocb {
    uint64_t   aio_data;
-   uint16_t   aio_key;
-   uint16_t   aio_rw_flags;
+   uint32_t   aio_key;
+   uint32_t   aio_rw_flags;
    uint16_t   aio_lio_opcode;
    int16_t   aio_reqprio;
    uint32_t   aio_fildes;
@@ -1636,15 +1636,15 @@ static int rev_unshare(unsigned long unshare_flags){
   return rc;
 }
 
-// int rev_futex(uint32_t  *uaddr, int op, uint32_t val, struct __kernel_timespec  *utime, uint32_t  *uaddr2, uint32_t val3){
-//   int rc;
-//   asm volatile (
-//     "li a7, 98 \n\t"
-//     "ecall \n\t"
-//     "mv %0, a0" : "=r" (rc)
-//     );
-//   return rc;
-// }
+static int rev_futex(uint32_t  *uaddr, int op, uint32_t val, struct __kernel_timespec  *utime, uint32_t  *uaddr2, uint32_t val3){
+  int rc;
+  asm volatile (
+    "li a7, 98 \n\t"
+    "ecall \n\t"
+    "mv %0, a0" : "=r" (rc)
+    );
+  return rc;
+}
 
 static int rev_set_robust_list(struct robust_list_head  *head, size_t len){
   int rc;
@@ -3783,6 +3783,17 @@ static int rev_perf_stats(struct rev_stats *stats) {
   return rc;
 }
 
+// Dumps the trace flight recorder of the calling core (see trcRing)
+static int rev_trace_dump() {
+  int rc;
+  asm volatile (
+    "li a7, 502 \n\t"
+    "ecall \n\t"
+    "mv %0, a0" : "=r" (rc)
+    );
+  return rc;
+}
+
 typedef unsigned long int rev_pthread_t;
 
 // pthread_t *restrict thread
@@ -0,0 +1,162 @@
+//
+// _RevAIO_h_
+//
+// Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _SST_REVCPU_REVAIO_H_
+#define _SST_REVCPU_REVAIO_H_
+
+// -- Standard Headers
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+namespace SST::RevCPU{
+
+/*! \class RevAIO
+ *  \brief Linux AIO (io_setup/io_submit/io_getevents) backed by host workers
+ *
+ * Requests are executed by a pool of host threads directly against the
+ * host pages that back guest memory, so the simulation keeps clocking
+ * while the host performs the I/O.  Each request is also assigned a
+ * simulated completion cycle from a simple storage model: requests are
+ * serviced one at a time at Bandwidth bytes per cycle, and complete
+ * Latency cycles after their transfer.  A completion becomes visible to
+ * io_getevents when the simulation reaches its completion cycle; if the
+ * host I/O has not finished by then the simulation waits for it (or
+ * performs it itself if no worker has started it), so simulated completion
+ * times do not depend on the speed of the host.
+ *
+ * All methods other than the workers' are called from the simulation thread.
+ */
+class RevAIO{
+public:
+  /// RevAIO: operation requested by an iocb
+  enum class Op{ Read, Write, Fsync, Fdsync, Noop };
+
+  /// RevAIO: completion event (mirrors struct io_event)
+  struct Event{
+    uint64_t Data;    ///< Event: aio_data from the iocb
+    uint64_t Obj;     ///< Event: guest address of the iocb
+    int64_t  Res;     ///< Event: bytes transferred or negative errno
+    int64_t  Res2;    ///< Event: secondary result (always 0)
+  };
+
+  /// RevAIO: constructor; Threads host workers service the requests once
+  /// the first context is created
+  RevAIO(unsigned Threads, uint64_t Latency, uint64_t Bandwidth);
+
+  /// RevAIO: destructor; waits for in-flight host I/O and joins the workers
+  ~RevAIO();
+
+  /// RevAIO: disallow copying and assignment
+  RevAIO(const RevAIO&) = delete;
+  RevAIO& operator=(const RevAIO&) = delete;
+
+  /// RevAIO: create a context holding up to MaxEvents requests; returns its id
+  uint64_t Setup(unsigned MaxEvents);
+
+  /// RevAIO: destroy a context, cancelling its queued requests
+  bool Destroy(uint64_t Ctx);
+
+  /// RevAIO: determines whether Ctx is a live context
+  bool Valid(uint64_t Ctx) const { return Contexts.count(Ctx) != 0; }
+
+  /// RevAIO: retrieve the number of requests Ctx can hold (0 if it is not live)
+  unsigned Capacity(uint64_t Ctx) const {
+    auto it = Contexts.find(Ctx);
+    return it == Contexts.end() ? 0 : it->second.MaxEvents;
+  }
+
+  /// RevAIO: submit a request; returns 0 or a negative errno
+  int Submit(uint64_t Ctx, uint64_t Data, uint64_t Obj, Op Oper, int Fd,
+             std::vector<iovec>&& Iov, off_t Offset, uint64_t Bytes);
+
+  /// RevAIO: retrieve the number of completions of Ctx that are due
+  size_t Ready(uint64_t Ctx) const;
+
+  /// RevAIO: append up to Max due completions of Ctx to Out, oldest first,
+  /// waiting for any of their host I/O that is still running
+  size_t Reap(uint64_t Ctx, size_t Max, std::vector<Event>& Out);
+
+  /// RevAIO: cancel the request for iocb Obj if no worker has started it
+  bool Cancel(uint64_t Ctx, uint64_t Obj, Event& Out);
+
+  /// RevAIO: advance the simulated clock to Cycle, finishing the host I/O of
+  /// every request that is due
+  void Advance(uint64_t Cycle){
+    Now = Cycle;
+    if( Now >= NextDue )
+      FinishDue();
+  }
+
+  /// RevAIO: retrieve the current simulated cycle
+  uint64_t GetCycle() const { return Now; }
+
+private:
+  /// RevAIO: in-flight request
+  struct Request{
+    uint64_t Data;                    ///< Request: aio_data
+    uint64_t Obj;                     ///< Request: guest iocb address
+    Op Oper;                          ///< Request: operation
+    int Fd;                           ///< Request: host file descriptor
+    std::vector<iovec> Iov;           ///< Request: host buffers in guest memory
+    off_t Offset;                     ///< Request: file offset
+    uint64_t DueCycle;                ///< Request: simulated completion cycle
+    bool Started = false;             ///< Request: picked up by a worker (guarded by Lock)
+    int64_t Res = 0;                  ///< Request: result, valid once Done
+    bool Done = false;                ///< Request: host I/O has finished (guarded by Lock)
+  };
+
+  /// RevAIO: AIO context
+  struct Context{
+    unsigned MaxEvents;                            ///< Context: request limit
+    std::list<std::shared_ptr<Request>> Requests;  ///< Context: requests in submission order
+  };
+
+  /// RevAIO: worker thread body
+  void Worker();
+
+  /// RevAIO: perform the host I/O for a request
+  static int64_t Execute(Request& R);
+
+  /// RevAIO: wait for the host I/O of a request, performing it here if no worker has started it
+  void Finish(const std::shared_ptr<Request>& R);
+
+  /// RevAIO: finish every request that is due and find the next due cycle
+  void FinishDue();
+
+  unsigned Threads;                   ///< RevAIO: number of host workers
+  uint64_t Latency;                   ///< RevAIO: cycles from transfer to completion
+  uint64_t Bandwidth;                 ///< RevAIO: bytes per cycle (0 is unlimited)
+  uint64_t Now = 0;                   ///< RevAIO: current simulated cycle
+  uint64_t DeviceFree = 0;            ///< RevAIO: cycle the modeled device is next idle
+  uint64_t NextCtx = 1;               ///< RevAIO: next context id
+  uint64_t NextDue = UINT64_MAX;      ///< RevAIO: earliest completion cycle of an unfinished request
+
+  std::unordered_map<uint64_t, Context> Contexts{};   ///< RevAIO: live contexts
+
+  std::mutex Lock{};                                  ///< RevAIO: guards Queue, Stop and Request::Started
+  std::condition_variable Wakeup{};                   ///< RevAIO: signals the workers
+  std::condition_variable Finished{};                 ///< RevAIO: signals that a request is Done
+  std::deque<std::shared_ptr<Request>> Queue{};       ///< RevAIO: requests awaiting a worker
+  bool Stop = false;                                  ///< RevAIO: tells the workers to exit
+  std::vector<std::thread> Workers{};                 ///< RevAIO: host worker pool
+};
+
+} // namespace SST::RevCPU
+
+#endif // _SST_REVCPU_REVAIO_H_
@@ -16,6 +16,7 @@
 #include <vector>
 #include <queue>
 #include <tuple>
+#include <deque>
 #include <list>
 #include <stdio.h>
 #include <stdlib.h>
@@ -36,6 +37,10 @@
 #include "RevLoader.h"
 #include "RevProc.h"
 #include "RevThread.h"
+#include "RevAIO.h"
+#include "RevVFS.h"
+#include "RevReplay.h"
+#include "RevTimerWheel.h"
 #include "RevNIC.h"
 #include "RevCoProc.h"
 #include "RevRand.h"
@@ -57,6 +62,9 @@ public:
   /// RevCPU: standard SST component 'finish' function
   void finish();
 
+  /// RevCPU: standard SST component 'emergencyShutdown' function
+  void emergencyShutdown() override;
+
   /// RevCPU: standard SST component 'init' function
   void init( unsigned int phase );
 
@@ -92,7 +100,22 @@ public:
     {"machine",         "RISC-V machine model of the target core",      "core:G"},
     {"memCost",         "Memory latency range in cycles min:max",       "core:0:10"},
     {"prefetchDepth",   "Instruction prefetch depth per core",          "core:1"},
+    {"lsqDepth",        "Load/store queue entries per hart (0 disables)", "core:16"},
+    {"syscallBandwidth", "Bytes per cycle copied by system calls (0 is free)", "core:8"},
     {"table",           "Instruction cost table",                       "core:/path/to/table"},
+    {"syscallTable",    "System call cost table",                       "core:/path/to/table"},
+    {"aioThreads",      "Host worker threads servicing guest AIO requests", "4"},
+    {"aioLatency",      "Simulated AIO completion latency in cycles",   "1000"},
+    {"aioBandwidth",    "Simulated AIO storage bandwidth in bytes per cycle (0 is unlimited)", "8"},
+    {"recordLog",       "Record host syscall results and random draws to this file", ""},
+    {"replayLog",       "Replay host syscall results and random draws from this file", ""},
+    {"timeSlice",       "Cycles a thread runs before it is preempted for a waiting thread (0 disables)", "0"},
+    {"contextSwitchCost", "Cycles a hart stalls after preempting a thread", "100"},
+    {"threadAffinity",  "[N:mask] hex CPU mask (CPU = core*numHarts+hart) of the Nth thread created, or of all others with THREADS", "[]"},
+    {"schedPolicy",     "Placement of new threads on cores: roundrobin, fill or spread", "roundrobin"},
+    {"enableVFS",       "Serve guest file I/O from an in-memory filesystem", "0"},
+    {"vfsPreload",      "Host files or directories loaded into the in-memory filesystem", "[]"},
+    {"vfsDumpDir",      "Host directory the in-memory filesystem is written to at finish", ""},
     {"enable_nic",      "Enable the internal RevNIC",                   "0"},
     {"enable_pan",      "Enable PAN network endpoint",                  "0"},
     {"enable_test",     "Enable PAN network endpoint test",             "0"},
@@ -110,6 +133,17 @@ public:
     {"trcOp",           "Tracer instruction trigger",                   "slli"},
     {"trcLimit",        "Max trace lines per core (0 no limit)",        "0"},
     {"trcStartCycle",   "Starting tracer cycle (disables trcOp)",       "0"},
+    {"trcFile",         "Write a compact binary trace to <trcFile>.<core> instead of text", ""},
+    {"trcRing",         "Instructions per hart kept by the trace flight recorder (0 disables)", "0"},
+    {"trcDumpAt",       "Symbols or addresses that dump the trace flight recorder", "[]"},
+    {"trcSymbols",      "Only trace instructions in these functions",  "[]"},
+    {"trcRange",        "Only trace instructions in these address ranges lo-hi (hi excluded)", "[]"},
+    {"trcHarts",        "Only trace these harts",                       "[]"},
+    {"trcThreads",      "Only trace these thread IDs",                  "[]"},
+    {"trcClass",        "Only trace these instruction classes: mem, branch", "[]"},
+    {"trcAsync",        "Format and print the text trace on a writer thread", "0"},
+    {"trcQueue",        "Records queued for the trace writer thread",   "65536"},
+    {"trcFull",         "When the trace writer queue is full: block or drop", "block"},
     {"splash",          "Display the splash logo",                      "0"},
     {"independentCoprocClock",  "Enables each coprocessor to register its own clock handler", "0"},
     )
@@ -194,6 +228,23 @@ public:
     {"FloatsExec",          "Total SP or DP float instructions executed",           "count",  1},
     {"TLBHitsPerCore",      "TLB hits per core",                                    "count",  1},
     {"TLBMissesPerCore",    "TLB misses per core",                                  "count",  1},
+    {"LSQForwards",         "Loads satisfied by store-to-load forwarding",          "count",  1},
+    {"LSQViolations",       "Loads partially overlapping an in-flight store",       "count",  1},
+    {"LSQFullStalls",       "Stores stalled on a full load/store queue",            "count",  1},
+    {"CyclesStalledLSQ",    "Cycles stalled on a full load/store queue",            "count",  1},
+    {"SyscallsExec",        "System calls completed",                               "count",  1},
+    {"SyscallCycles",       "Cycles from issue to completion of system calls",      "count",  1},
+    {"SyscallBytes",        "Bytes copied between guest memory and the host by system calls", "count", 1},
+    {"SyscallCalls",        "Calls of one system call (subid core_<n>.<syscall number>)", "count", 1},
+    {"SyscallCallCycles",   "Cycles from issue to completion of one system call (subid core_<n>.<syscall number>)", "count", 1},
+    {"SyscallCallBytes",    "Bytes copied by one system call (subid core_<n>.<syscall number>)", "count", 1},
+    {"Preemptions",         "Threads preempted at the end of their time slice",     "count",  1},
+    {"ContextSwitchCycles", "Cycles harts stalled switching threads after a preemption", "count", 1},
+    {"ThreadMigrations",    "Ready threads stolen from the queue of another core",  "count",  1},
+    {"ReadyQueueDepth",     "Depth of the ready queue each time a thread is queued", "count", 1},
+    {"FutexWaits",          "Threads blocked in FUTEX_WAIT",                        "count",  1},
+    {"FutexWakes",          "Threads woken from FUTEX_WAIT",                        "count",  1},
+    {"FutexBlockedCycles",  "Cycles threads spent blocked in FUTEX_WAIT",           "count",  1},
 
     {"TLBHits",             "TLB hits",                                             "count",  1},
     {"TLBMisses",           "TLB misses",                                           "count",  1},
@@ -205,6 +256,15 @@ public:
     return std::function<uint32_t()>([this]() { return GetNewThreadID(); });
   }
 
+  // Passed to each RevProc so that futex wake/requeue operations can reach
+  // the wait queues held by this RevCPU
+  RevProc::FutexWakeFunc GetFutexWake() {
+    return RevProc::FutexWakeFunc([this](uint64_t Addr, uint64_t NWake, uint32_t Bitset,
+                                         uint64_t Addr2, uint64_t NRequeue) {
+      return FutexWake(Addr, NWake, Bitset, Addr2, NRequeue);
+    });
+  }
+
 private:
   unsigned numCores;                  ///< RevCPU: number of RISC-V cores
   unsigned numHarts;                  ///< RevCPU: number of RISC-V cores
@@ -218,6 +278,11 @@ private:
   RevMem *Mem;                        ///< RevCPU: RISC-V main memory object
   RevLoader *Loader;                  ///< RevCPU: RISC-V loader
   std::vector<RevProc *> Procs;       ///< RevCPU: RISC-V processor objects
+  std::unique_ptr<RevAIO> AIO;        ///< RevCPU: asynchronous I/O shared by all cores
+  std::vector<std::unique_ptr<RevTracer>> Tracers; ///< RevCPU: per core instruction tracers
+  std::unique_ptr<RevVFS> VFS;        ///< RevCPU: in-memory filesystem shared by all cores
+  std::string VFSDumpDir;             ///< RevCPU: host directory the VFS is written to at finish
+  std::unique_ptr<RevReplay> Replay;  ///< RevCPU: record/replay log of host inputs, if enabled
   bool *Enabled;                      ///< RevCPU: Completion structure
 
   // Initializes a RevThread object.
@@ -234,33 +299,93 @@ private:
   // Sets up arguments for a thread with a given ID and feature set.
   void SetupArgs(const std::unique_ptr<RevRegFile>& RegFile);
 
-  // Checks the status of ALL threads that are currently blocked.
-  void CheckBlockedThreads();
-
   // Checks core w/ ProcID to see if it has any available harts to assign work to
-  // if it does and there is work to assign (ie. ThreadQueue is not empty)
-  // assign it and enable the processor if not already enabled.
+  // if it does and there is work to assign (ie. its ready queue is not empty,
+  // or another busy core has queued work to steal) assign it and enable the
+  // processor if not already enabled.
   void UpdateThreadAssignments(uint32_t ProcID);
 
   // Checks for state changes in the threads of a given processor index 'ProcID'
   // and handle appropriately
   void HandleThreadStateChangesForProc(uint32_t ProcID);
 
-  // Checks if a thread with a given Thread ID can proceed (used for pthread_join).
-  // it does this by seeing if a given thread's WaitingOnTID has completed
-  bool ThreadCanProceed(const std::unique_ptr<RevThread>& Thread);
+  // Parks a thread blocked in pthread_join until the thread it joins completes
+  void JoinThread(std::unique_ptr<RevThread>&& Thread);
+
+  // Readies every thread waiting to join the completed thread ThreadID
+  void WakeJoinWaiters(uint32_t ThreadID);
+
+  // Placement of threads that have not run yet
+  enum class SchedPolicy { RoundRobin, FillFirst, Spread };
+  SchedPolicy Policy = SchedPolicy::RoundRobin;
+  unsigned NextCore = 0;              ///< RevCPU: next core for round-robin placement
+
+  // Per-core queues of Threads which are ready to be scheduled.  A core
+  // takes threads from the front of its own queue; an idle core steals
+  // from the back of the longest queue of a core with no idle hart.
+  std::vector<std::deque<std::unique_ptr<RevThread>>> ReadyQueues = {};
+
+  // Queues a ready thread on the core it last ran on, or on the core chosen
+  // by the placement policy if it has never run
+  void ScheduleThread(std::unique_ptr<RevThread>&& Thread);
+
+  // Chooses the core for a thread that has never run (or may no longer run
+  // on its last core)
+  unsigned PlaceThread(const RevThread& Thread);
+
+  // Affinity masks given to threads by the threadAffinity parameter, keyed
+  // by creation order, and the mask for threads without an entry (0 is none)
+  std::unordered_map<uint64_t, uint64_t> ThreadAffinity = {};
+  uint64_t DefaultAffinity = 0;
+  uint64_t ThreadsCreated = 0;        ///< RevCPU: threads created so far, including the main thread
+
+  // Applies the configured affinity to a newly created thread
+  void ApplyThreadAffinity(RevThread& Thread);
 
-  // vector of Threads which are ready to be scheduled
-  std::vector<std::unique_ptr<RevThread>> ReadyThreads = {};
+  // Returns the number of threads running on or queued for core ProcID
+  size_t GetCoreLoad(unsigned ProcID) const { return Procs[ProcID]->GetNumBusyHarts() + ReadyQueues[ProcID].size(); }
 
-  // List of Threads that are currently blocked (waiting for their WaitingOnTID to be a key in CompletedThreads).
-  std::list<std::unique_ptr<RevThread>> BlockedThreads = {};
+  // Returns true if any core has a thread queued
+  bool HasReadyThreads() const;
+
+  // Threads blocked in pthread_join, keyed by the TID they are waiting to join
+  std::unordered_map<uint32_t, std::vector<std::unique_ptr<RevThread>>> JoinWaiters = {};
+
+  // Threads blocked in FUTEX_WAIT, queued in FIFO order by futex address
+  std::unordered_map<uint64_t, std::list<std::unique_ptr<RevThread>>> FutexQueues = {};
+
+  // Wakes up to NWake threads waiting on Addr whose bitset matches, then
+  // requeues up to NRequeue of the remaining waiters onto Addr2
+  uint64_t FutexWake(uint64_t Addr, uint64_t NWake, uint32_t Bitset, uint64_t Addr2, uint64_t NRequeue);
+
+  // Threads descheduled by nanosleep/pause, keyed by thread ID
+  std::unordered_map<uint32_t, std::unique_ptr<RevThread>> SleepingThreads = {};
+
+  // Futex address of each thread that is waiting on a futex with a timeout
+  std::unordered_map<uint32_t, uint64_t> TimedFutexWaiters = {};
+
+  // Wake-up timers for sleeping threads and futex timeouts, keyed on cycles
+  RevTimerWheel SleepTimers{};
+
+  // Wakes the thread with ID ThreadID whose timer expired at cycle When
+  void ExpireSleepTimer(uint32_t ThreadID, uint64_t When);
+
+  // Moves a woken thread to a ready queue
+  void WakeThread(std::unique_ptr<RevThread>&& Thread);
+
+  uint64_t CurrentCycle = 0;          ///< RevCPU: cycle currently being clocked
 
   // Set of Thread IDs and their corresponding RevThread that have completed their execution on this RevCPU
+  // and have not been joined yet
   std::unordered_map<uint32_t, std::unique_ptr<RevThread>> CompletedThreads = {};
+  uint64_t ThreadsCompleted = 0;      ///< RevCPU: threads that have completed, including reclaimed ones
+
+  // Returns the resources of a joined (or detached) thread to their pools
+  // and drops its record
+  void ReclaimThread(uint32_t ThreadID);
 
-  // Generates a new Thread ID using the RNG.
-  uint32_t GetNewThreadID() { return RevRand(0, UINT32_MAX); }
+  // Generates a new Thread ID using the RNG (or the replay log)
+  uint32_t GetNewThreadID();
 
   uint8_t PrivTag;                    ///< RevCPU: private tag locator
   uint32_t LToken;                    ///< RevCPU: token identifier for PAN Test
@@ -374,6 +499,28 @@ private:
   std::vector<Statistic<uint64_t>*> FloatsExec;
   std::vector<Statistic<uint64_t>*> TLBMissesPerCore;
   std::vector<Statistic<uint64_t>*> TLBHitsPerCore;
+  std::vector<Statistic<uint64_t>*> LSQForwards;
+  std::vector<Statistic<uint64_t>*> LSQViolations;
+  std::vector<Statistic<uint64_t>*> LSQFullStalls;
+  std::vector<Statistic<uint64_t>*> CyclesStalledLSQ;
+  std::vector<Statistic<uint64_t>*> SyscallsExec;
+  std::vector<Statistic<uint64_t>*> SyscallCycles;
+  std::vector<Statistic<uint64_t>*> SyscallBytes;
+  /// RevCPU: statistics of one system call on one core
+  struct SyscallStats{
+    Statistic<uint64_t>* Calls;
+    Statistic<uint64_t>* Cycles;
+    Statistic<uint64_t>* Bytes;
+  };
+  std::vector<std::map<uint32_t, SyscallStats>> SyscallProfile;
+  std::vector<Statistic<uint64_t>*> Preemptions;
+  std::vector<Statistic<uint64_t>*> ContextSwitchCycles;
+  std::vector<Statistic<uint64_t>*> ThreadMigrations;
+  std::vector<Statistic<uint64_t>*> ReadyQueueDepth;
+
+  Statistic<uint64_t>* FutexWaits;
+  Statistic<uint64_t>* FutexWakes;
+  Statistic<uint64_t>* FutexBlockedCycles;
 
   //-------------------------------------------------------
   // -- FUNCTIONS
@@ -12,6 +12,7 @@
 #define _SST_REVCPU_REVHART_H_
 
 // -- SST Headers
+#include "RevLSQ.h"
 #include "RevSysCalls.h"
 #include "RevThread.h"
 #include "SST.h"
@@ -29,20 +30,30 @@ class RevHart{
   const std::shared_ptr<std::unordered_multimap<uint64_t, MemReq>>& LSQueue;
 
   ///< RevHart: Pointer to the Proc's MarkLoadCompleteFunc
-  std::function<void(const MemReq&)> MarkLoadCompleteFunc;
+  MemReqCompletion MarkLoadCompleteFunc;
+
+  ///< RevHart: Load/store queue holding this Hart's stores in flight
+  std::unique_ptr<RevLSQ> LSQ;
 
   ///< RevHart: Thread currently executing on this Hart
   std::unique_ptr<RevThread> Thread = nullptr;
   std::unique_ptr<RevRegFile> RegFile = nullptr;
 
+  ///< RevHart: Cycles the current thread has held this Hart
+  uint64_t SliceCycles = 0;
+
+  ///< RevHart: Cycles left before this Hart may decode after a context switch
+  uint64_t SwitchCycles = 0;
+
   ///< RevHart: Make RevProc a friend of this
   friend class RevProc;
 
 public:
   ///< RevHart: Constructor
   RevHart(unsigned ID, const std::shared_ptr<std::unordered_multimap<uint64_t, MemReq>>& LSQueue,
-          std::function<void(const MemReq&)> MarkLoadCompleteFunc)
-    : ID(ID), LSQueue(LSQueue), MarkLoadCompleteFunc(std::move(MarkLoadCompleteFunc)) {}
+          MemReqCompletion MarkLoadCompleteFunc, unsigned LSQDepth)
+    : ID(ID), LSQueue(LSQueue), MarkLoadCompleteFunc(MarkLoadCompleteFunc),
+      LSQ(std::make_unique<RevLSQ>(LSQDepth)) {}
 
   ///< RevHart: Destructor
   ~RevHart() = default;
@@ -54,6 +65,18 @@ public:
   ///< RevHart: Get Hart's ID
   uint16_t GetID() const { return ID; }
 
+  ///< RevHart: Get the Hart's load/store queue
+  RevLSQ* GetLSQ() const { return LSQ.get(); }
+
+  ///< RevHart: Advance the time slice and context switch counters by one cycle
+  void Tick(){
+    if( SwitchCycles ){
+      SwitchCycles--;
+    }else if( Thread ){
+      SliceCycles++;
+    }
+  }
+
   ///< RevHart: Returns the ID of the assigned thread
   uint32_t GetAssignedThreadID() const { return (Thread != nullptr) ? Thread->GetID() : _INVALID_TID_; }
 
@@ -62,17 +85,23 @@ public:
     RegFile = std::move(regFile);
     RegFile->SetMarkLoadComplete(MarkLoadCompleteFunc);
     RegFile->SetLSQueue(LSQueue);
+    RegFile->SetLSQ(LSQ.get());
   }
 
   ///< RevHart: Assigns a RevThread to this Hart
   void AssignThread(std::unique_ptr<RevThread> ThreadToAssign){
     Thread = std::move(ThreadToAssign);
     Thread->SetState(ThreadState::RUNNING);
+    SliceCycles = 0;
     LoadRegFile(Thread->TransferVirtRegState());
   }
 
   ///< RevHart: Removed a RevThread from this Hart
   std::unique_ptr<RevThread> PopThread(){
+    // stores in flight belong to the departing thread
+    LSQ->Drain();
+    RegFile->SetLSQ(nullptr);
+
     // return the register file to the thread
     Thread->UpdateVirtRegState(std::move(RegFile));
     // return the thread
@@ -63,9 +63,33 @@ unsigned fclass(T val, bool quietNaN = true) {
   }
 }
 
+/// Probe the hart's load/store queue before a load is issued to memory.
+/// A load fully covered by an in-flight store receives the store data and
+/// completes immediately; a partially overlapping load stalls until the
+/// store drains.  Returns true if the load was forwarded
+template<typename T>
+bool LSQForward(RevRegFile *R, uint64_t Addr, T *Target, const MemReq& req) {
+  RevLSQ *LSQ = R->GetLSQ();
+  if( !LSQ )
+    return false;
+
+  uint32_t Stall = 0;
+  switch( LSQ->ProbeLoad(Addr, sizeof(T), Target, Stall) ){
+  case RevLSQ::LoadStatus::Forward:
+    req.MarkLoadComplete();
+    return true;
+  case RevLSQ::LoadStatus::Violation:
+    R->GetCost() += Stall;
+    return false;
+  default:
+    return false;
+  }
+}
+
 /// Load template
 template<typename T>
 bool load(RevFeature *F, RevRegFile *R, RevMem *M, const RevInst& Inst) {
+  bool Forwarded;
   if( sizeof(T) < sizeof(int64_t) && R->IsRV32 ){
     static constexpr RevFlag flags = sizeof(T) < sizeof(int32_t) ?
       std::is_signed_v<T> ? RevFlag::F_SEXT32 : RevFlag::F_ZEXT32 : RevFlag::F_NONE;
@@ -76,12 +100,15 @@ bool load(RevFeature *F, RevRegFile *R, RevMem *M, const RevInst& Inst) {
                MemOp::MemOpREAD,
                true,
                R->GetMarkLoadComplete());
-    R->LSQueue->insert(req.LSQHashPair());
-    M->ReadVal(F->GetHartToExecID(),
-               rs1 + Inst.ImmSignExt(12),
-               reinterpret_cast<std::make_unsigned_t<T>*>(&R->RV32[Inst.rd]),
-               std::move(req),
-               flags);
+    R->LSQInsert(req);
+    auto *Target = reinterpret_cast<std::make_unsigned_t<T>*>(&R->RV32[Inst.rd]);
+    Forwarded = LSQForward(R, rs1 + Inst.ImmSignExt(12), Target, req);
+    if( !Forwarded )
+      M->ReadVal(F->GetHartToExecID(),
+                 rs1 + Inst.ImmSignExt(12),
+                 Target,
+                 std::move(req),
+                 flags);
     R->SetX(Inst.rd, static_cast<T>(R->RV32[Inst.rd]));
 
   }else{
@@ -94,27 +121,41 @@ bool load(RevFeature *F, RevRegFile *R, RevMem *M, const RevInst& Inst) {
                MemOp::MemOpREAD,
                true,
                R->GetMarkLoadComplete());
-    R->LSQueue->insert(req.LSQHashPair());
-    M->ReadVal(F->GetHartToExecID(),
-               rs1 + Inst.ImmSignExt(12),
-               reinterpret_cast<std::make_unsigned_t<T>*>(&R->RV64[Inst.rd]),
-               std::move(req),
-               flags);
+    R->LSQInsert(req);
+    auto *Target = reinterpret_cast<std::make_unsigned_t<T>*>(&R->RV64[Inst.rd]);
+    Forwarded = LSQForward(R, rs1 + Inst.ImmSignExt(12), Target, req);
+    if( !Forwarded )
+      M->ReadVal(F->GetHartToExecID(),
+                 rs1 + Inst.ImmSignExt(12),
+                 Target,
+                 std::move(req),
+                 flags);
     R->SetX(Inst.rd, static_cast<T>(R->RV64[Inst.rd]));
   }
 
-  // update the cost
-  R->cost += M->RandCost(F->GetMinCost(), F->GetMaxCost());
+  // update the cost; forwarded loads never leave the hart
+  R->cost += Forwarded ? F->GetMinCost() : M->RandCost(F->GetMinCost(), F->GetMaxCost());
   R->AdvancePC(Inst);
   return true;
 }
 
+/// Record a store in the hart's load/store queue.  The store remains in
+/// flight for the memory latency; a full queue stalls the hart until the
+/// oldest store drains
+template<typename T>
+void LSQStore(RevFeature *F, RevRegFile *R, RevMem *M, uint64_t Addr, const T& Value) {
+  if( RevLSQ *LSQ = R->GetLSQ() )
+    R->GetCost() += LSQ->InsertStore(Addr, &Value, sizeof(T),
+                                     M->RandCost(F->GetMinCost(), F->GetMaxCost()));
+}
+
 /// Store template
 template<typename T>
 bool store(RevFeature *F, RevRegFile *R, RevMem *M, const RevInst& Inst) {
-  M->Write(F->GetHartToExecID(),
-           R->GetX<uint64_t>(Inst.rs1) + Inst.ImmSignExt(12),
-           R->GetX<T>(Inst.rs2));
+  uint64_t Addr = R->GetX<uint64_t>(Inst.rs1) + Inst.ImmSignExt(12);
+  T val = R->GetX<T>(Inst.rs2);
+  M->Write(F->GetHartToExecID(), Addr, val);
+  LSQStore(F, R, M, Addr, val);
   R->AdvancePC(Inst);
   return true;
 }
@@ -122,6 +163,7 @@ bool store(RevFeature *F, RevRegFile *R, RevMem *M, const RevInst& Inst) {
 /// Floating-point load template
 template<typename T>
 bool fload(RevFeature *F, RevRegFile *R, RevMem *M, const RevInst& Inst) {
+  bool Forwarded;
   if(std::is_same_v<T, double> || F->HasD()){
     static constexpr RevFlag flags = sizeof(T) < sizeof(double) ?
       RevFlag::F_BOXNAN : RevFlag::F_NONE;
@@ -134,12 +176,15 @@ bool fload(RevFeature *F, RevRegFile *R, RevMem *M, const RevInst& Inst) {
                MemOp::MemOpREAD,
                true,
                R->GetMarkLoadComplete());
-    R->LSQueue->insert(req.LSQHashPair());
-    M->ReadVal(F->GetHartToExecID(),
-               rs1 + Inst.ImmSignExt(12),
-               reinterpret_cast<T*>(&R->DPF[Inst.rd]),
-               std::move(req),
-               flags);
+    R->LSQInsert(req);
+    auto *Target = reinterpret_cast<T*>(&R->DPF[Inst.rd]);
+    Forwarded = LSQForward(R, rs1 + Inst.ImmSignExt(12), Target, req);
+    if( !Forwarded )
+      M->ReadVal(F->GetHartToExecID(),
+                 rs1 + Inst.ImmSignExt(12),
+                 Target,
+                 std::move(req),
+                 flags);
 
     // Box float value into 64-bit FP register
     if(std::is_same_v<T, float>){
@@ -156,15 +201,17 @@ bool fload(RevFeature *F, RevRegFile *R, RevMem *M, const RevInst& Inst) {
                MemOp::MemOpREAD,
                true,
                R->GetMarkLoadComplete());
-    R->LSQueue->insert(req.LSQHashPair());
-    M->ReadVal(F->GetHartToExecID(),
-               rs1 + Inst.ImmSignExt(12),
-               &R->SPF[Inst.rd],
-               std::move(req),
-               RevFlag::F_NONE);
+    R->LSQInsert(req);
+    Forwarded = LSQForward(R, rs1 + Inst.ImmSignExt(12), &R->SPF[Inst.rd], req);
+    if( !Forwarded )
+      M->ReadVal(F->GetHartToExecID(),
+                 rs1 + Inst.ImmSignExt(12),
+                 &R->SPF[Inst.rd],
+                 std::move(req),
+                 RevFlag::F_NONE);
   }
-  // update the cost
-  R->cost += M->RandCost(F->GetMinCost(), F->GetMaxCost());
+  // update the cost; forwarded loads never leave the hart
+  R->cost += Forwarded ? F->GetMinCost() : M->RandCost(F->GetMinCost(), F->GetMaxCost());
   R->AdvancePC(Inst);
   return true;
 }
@@ -172,8 +219,10 @@ bool fload(RevFeature *F, RevRegFile *R, RevMem *M, const RevInst& Inst) {
 /// Floating-point store template
 template<typename T>
 bool fstore(RevFeature *F, RevRegFile *R, RevMem *M, const RevInst& Inst) {
+  uint64_t Addr = R->GetX<uint64_t>(Inst.rs1) + Inst.ImmSignExt(12);
   T val = R->GetFP<T, true>(Inst.rs2);
-  M->Write(F->GetHartToExecID(), R->GetX<uint64_t>(Inst.rs1) + Inst.ImmSignExt(12), val);
+  M->Write(F->GetHartToExecID(), Addr, val);
+  LSQStore(F, R, M, Addr, val);
   R->AdvancePC(Inst);
   return true;
 }
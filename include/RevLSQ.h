@@ -0,0 +1,161 @@
+//
+// _RevLSQ_h_
+//
+// Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _SST_REVCPU_REVLSQ_H_
+#define _SST_REVCPU_REVLSQ_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <utility>
+
+namespace SST::RevCPU{
+
+/*! \class RevLSQ
+ *  \brief Per-hart load/store queue
+ *
+ * Stores are written to RevMem as soon as they execute, but they remain
+ * in flight in the LSQ until their memory latency has drained.  Younger
+ * loads from the same hart probe the queue first: a load that is fully
+ * covered by an in-flight store receives the store data directly, while a
+ * load that only partially overlaps an in-flight store must wait for that
+ * store (and every older one) to drain before it can be issued to memory.
+ * Stores retire from the queue in program order.
+ */
+class RevLSQ{
+public:
+  /// RevLSQ: result of probing the queue with a load
+  enum class LoadStatus{
+    Miss,       ///< RevLSQ: no overlapping store in flight
+    Forward,    ///< RevLSQ: data forwarded from an in-flight store
+    Violation,  ///< RevLSQ: partial overlap; the load waits for the store to drain
+  };
+
+  /// RevLSQ: constructor; a depth of zero disables the queue
+  explicit RevLSQ(unsigned Depth) : Depth(Depth) {}
+
+  /// RevLSQ: destructor
+  ~RevLSQ() = default;
+
+  /// RevLSQ: retrieve the number of store entries
+  unsigned GetDepth() const { return Depth; }
+
+  /// RevLSQ: retrieve the number of stores currently in flight
+  size_t GetSize() const { return Stores.size(); }
+
+  /// RevLSQ: determines whether every store entry is occupied
+  bool IsFull() const { return Depth && Stores.size() >= Depth; }
+
+  /// RevLSQ: record a store in flight for Latency cycles.  Returns the
+  /// number of cycles the hart stalls waiting for a free entry
+  uint32_t InsertStore(uint64_t Addr, const void *Data, size_t Len, uint32_t Latency){
+    if( !Depth || Len > sizeof(uint64_t) )
+      return 0;
+
+    uint32_t Stall = 0;
+    if( IsFull() ){
+      // wait for the oldest store to drain
+      Stall = Retire(1);
+      FullStalls++;
+      FullStallCycles += Stall;
+    }
+
+    StoreEntry S{Addr, static_cast<uint32_t>(Len), 0, Latency};
+    memcpy(&S.Data, Data, Len);
+    Stores.push_back(S);
+    return Stall;
+  }
+
+  /// RevLSQ: probe the queue with a load of Len bytes from Addr.  On a
+  /// forward the store data is copied into Target; on a violation Stall
+  /// holds the number of cycles the load waits for the store to drain
+  LoadStatus ProbeLoad(uint64_t Addr, size_t Len, void *Target, uint32_t &Stall){
+    Stall = 0;
+    // the youngest overlapping store determines the loaded value
+    for( size_t i = Stores.size(); i > 0; i-- ){
+      const StoreEntry& S = Stores[i-1];
+      if( Addr >= S.Addr + S.Len || S.Addr >= Addr + Len )
+        continue;
+
+      if( Addr >= S.Addr && Addr + Len <= S.Addr + S.Len ){
+        memcpy(Target, reinterpret_cast<const uint8_t*>(&S.Data) + (Addr - S.Addr), Len);
+        Forwards++;
+        return LoadStatus::Forward;
+      }
+
+      Stall = Retire(i);
+      Violations++;
+      return LoadStatus::Violation;
+    }
+    return LoadStatus::Miss;
+  }
+
+  /// RevLSQ: advance every in-flight store by one cycle
+  void Tick(){
+    for( auto& S : Stores ){
+      if( S.Drain )
+        S.Drain--;
+    }
+    while( !Stores.empty() && Stores.front().Drain == 0 )
+      Stores.pop_front();
+  }
+
+  /// RevLSQ: drain every in-flight store.  Returns the number of cycles
+  /// required for the queue to empty
+  uint32_t Drain(){
+    return Retire(Stores.size());
+  }
+
+  /// RevLSQ: retrieve and clear the count of forwarded loads
+  uint64_t GetAndClearForwards(){ return std::exchange(Forwards, 0); }
+
+  /// RevLSQ: retrieve and clear the count of ordering violations
+  uint64_t GetAndClearViolations(){ return std::exchange(Violations, 0); }
+
+  /// RevLSQ: retrieve and clear the count of stores that found the queue full
+  uint64_t GetAndClearFullStalls(){ return std::exchange(FullStalls, 0); }
+
+  /// RevLSQ: retrieve and clear the cycles spent waiting on a full queue
+  uint64_t GetAndClearFullStallCycles(){ return std::exchange(FullStallCycles, 0); }
+
+private:
+  /// RevLSQ: in-flight store entry
+  struct StoreEntry{
+    uint64_t Addr;    ///< StoreEntry: target address
+    uint32_t Len;     ///< StoreEntry: store size in bytes
+    uint64_t Data;    ///< StoreEntry: store data
+    uint32_t Drain;   ///< StoreEntry: cycles until the store reaches memory
+  };
+
+  /// RevLSQ: retire the N oldest stores in program order.  Returns the
+  /// number of cycles elapsed and ages the remaining stores accordingly
+  uint32_t Retire(size_t N){
+    uint32_t Cycles = 0;
+    for( size_t i = 0; i < N; i++ )
+      Cycles = std::max(Cycles, Stores[i].Drain);
+    Stores.erase(Stores.begin(), Stores.begin() + N);
+    for( auto& S : Stores )
+      S.Drain = S.Drain > Cycles ? S.Drain - Cycles : 0;
+    return Cycles;
+  }
+
+  unsigned Depth;                   ///< RevLSQ: number of store entries
+  std::deque<StoreEntry> Stores{};  ///< RevLSQ: stores in flight, oldest first
+
+  uint64_t Forwards{};              ///< RevLSQ: loads satisfied by forwarding
+  uint64_t Violations{};            ///< RevLSQ: loads that partially overlapped a store
+  uint64_t FullStalls{};            ///< RevLSQ: stores that found the queue full
+  uint64_t FullStallCycles{};       ///< RevLSQ: cycles stalled on a full queue
+};
+
+} // namespace SST::RevCPU
+
+#endif // _SST_REVCPU_REVLSQ_H_
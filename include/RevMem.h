@@ -140,6 +140,12 @@ public:
   /// RevMem: Enable tracing of load and store instructions.
   void SetTracer(RevTracer* tracer) { Tracer = tracer; }
 
+  /// RevMem: set the number of harts on each core
+  void SetHartsPerCore(unsigned Harts) { HartsPerCore = Harts; }
+
+  /// RevMem: set the core whose harts issue the following requests
+  void SetActiveCore(unsigned Core) { ActiveCore = Core; }
+
   // ----------------------------------------------------
   // ---- Base Memory Interfaces
   // ----------------------------------------------------
@@ -155,6 +161,11 @@ public:
                 const MemReq& req,
                 RevFlag flags);
 
+  /// RevMem: retrieve a host pointer to the target address and the number of
+  /// bytes that may be accessed through it before the end of the page.
+  /// Returns nullptr when memory is backed by memHierarchy
+  char *GetHostPtr( uint64_t Addr, size_t &Len );
+
   /// RevMem: flush a cache line
   bool FlushLine( unsigned Hart, uint64_t Addr );
 
@@ -288,8 +299,13 @@ public:
   /// RevMem: Add new MemSegment (anywhere) --- Returns BaseAddr of segment
   uint64_t AddMemSeg(const uint64_t& SegSize);
 
-  /// RevMem: Add new thread mem (starting at TopAddr [growing down])
-  std::shared_ptr<MemSegment> AddThreadMem();
+  /// RevMem: Add new thread mem (starting at TopAddr [growing down]),
+  ///         reusing a released segment when there is one; Hart of the
+  ///         active core clears the TLS area of a reused segment
+  std::shared_ptr<MemSegment> AddThreadMem(unsigned Hart = 0);
+
+  /// RevMem: Return the memory of a thread that will never run again to the pool
+  void ReleaseThreadMem(const std::shared_ptr<MemSegment>& Seg);
 
   /// RevMem: Add new MemSegment (starting at BaseAddr)
   uint64_t AddMemSegAt(const uint64_t& BaseAddr, const uint64_t& SegSize);
@@ -359,6 +375,10 @@ protected:
   char *physMem = nullptr;                 ///< RevMem: memory container
 
 private:
+  /// RevMem: the memory controller is shared by every core, so it is given
+  /// CPU-wide hart IDs rather than the core-local ones used here
+  unsigned CtrlHart(unsigned Hart) const { return ActiveCore * HartsPerCore + Hart; }
+
   RevMemStats memStats = {};
   RevMemStats memStatsTotal = {};
 
@@ -375,7 +395,10 @@ private:
   std::vector<std::shared_ptr<MemSegment>> MemSegs;       // Currently Allocated MemSegs
   std::vector<std::shared_ptr<MemSegment>> FreeMemSegs;   // MemSegs that have been unallocated
   std::vector<std::shared_ptr<MemSegment>> ThreadMemSegs; // For each RevThread there is a corresponding MemSeg that contains TLS & Stack
+  std::vector<std::shared_ptr<MemSegment>> FreeThreadMemSegs; // Thread MemSegs released by reclaimed threads, reused by new threads
 
+  unsigned HartsPerCore = 1;                              ///< RevMem: harts on each core
+  unsigned ActiveCore = 0;                                ///< RevMem: core issuing the current requests
   uint64_t TLSBaseAddr;                                   ///< RevMem: TLS Base Address
   uint64_t TLSSize = sizeof(uint32_t);                    ///< RevMem: TLS Size (minimum size is enough to write the TID)
   uint64_t ThreadMemSize = _STACK_SIZE_;                  ///< RevMem: Size of a thread's memory segment (StackSize + TLSSize)
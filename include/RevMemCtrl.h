@@ -24,6 +24,7 @@
 #include <random>
 #include <tuple>
 #include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 // -- SST Headers
@@ -334,6 +335,10 @@ public:
                           { "max_writeunlock", "Sets the maximum number of outstanding writeunlock events", "64"},
                           { "max_custom",     "Sets the maximum number of outstanding custom events",     "64"},
                           { "ops_per_cycle",  "Sets the maximum number of operations to issue per cycle", "2" },
+                          { "max_mshr",       "Sets the maximum number of outstanding MSHR line fills (0 disables read coalescing)", "16" },
+                          { "max_mshr_targets", "Sets the maximum number of reads merged into a single MSHR line fill", "8" },
+                          { "max_wc_stores",  "Sets the maximum number of stores merged into a write-combining buffer (0 disables write combining)", "16" },
+                          { "wc_timeout",     "Sets the number of idle cycles before a write-combining buffer is flushed", "32" },
     )
 
   SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS({ "memIface", "Set the interface to memory", "SST::Interfaces::StandardMem" })
@@ -381,6 +386,12 @@ public:
     {"AMOMaxuPending",      "Counts the number of AMOMaxu operations pending",   "count", 1},
     {"AMOSwapBytes",        "Counts the number of bytes in AMOSwap transactions", "bytes", 1},
     {"AMOSwapPending",      "Counts the number of AMOSwap operations pending",   "count", 1},
+    {"MSHRAlloc",           "Counts the number of MSHR line fills allocated",   "count", 1},
+    {"MSHRMerge",           "Counts the number of reads merged into an outstanding MSHR line fill", "count", 1},
+    {"MSHRFull",            "Counts the number of reads that bypassed the MSHR table because it was full", "count", 1},
+    {"WCStores",            "Counts the number of stores absorbed by the write-combining buffers", "count", 1},
+    {"WCFlushes",           "Counts the number of write-combining buffer flushes", "count", 1},
+    {"WCWrites",            "Counts the number of write requests issued by write-combining buffer flushes", "count", 1},
     )
 
   enum MemCtrlStats : uint32_t {
@@ -424,6 +435,12 @@ public:
     AMOMaxuPending      = 37,
     AMOSwapBytes        = 38,
     AMOSwapPending      = 39,
+    MSHRAlloc           = 40,
+    MSHRMerge           = 41,
+    MSHRFull            = 42,
+    WCStores            = 43,
+    WCFlushes           = 44,
+    WCWrites            = 45,
   };
 
   /// RevBasicMemCtrl: constructor
@@ -589,6 +606,34 @@ private:
   /// RevBasicMemCtrl: build cache-aligned requests
   bool buildCacheMemRqst(RevMemOp *op, bool &Success);
 
+  /// RevBasicMemCtrl: determine if the read can be serviced by an MSHR line fill
+  bool isMSHRCandidate(RevMemOp *op);
+
+  /// RevBasicMemCtrl: merge a read into an outstanding MSHR line fill or allocate a new one
+  bool buildMSHRRqst(RevMemOp *op, bool &Success);
+
+  /// RevBasicMemCtrl: stop merging new reads into MSHR entries that overlap the target range
+  void closeMSHR(uint64_t Addr, uint32_t Size);
+
+  /// RevBasicMemCtrl: fan an MSHR line fill response out to all of its waiting reads
+  void handleMSHRResp(StandardMem::ReadResp* ev, std::vector<RevMemOp *>& Targets);
+
+  /// RevBasicMemCtrl: determine if the memory operation belongs to an AMO
+  bool isAMOOp(RevMemOp *op);
+
+  /// RevBasicMemCtrl: determine if the store can be merged into a write-combining buffer
+  bool isWCCandidate(uint64_t Addr, uint32_t Size, RevFlag flags);
+
+  /// RevBasicMemCtrl: merge a store into the hart's write-combining buffer
+  bool combineWRITERequest(unsigned Hart, uint64_t Addr, uint64_t PAddr,
+                           uint32_t Size, char *buffer, RevFlag flags);
+
+  /// RevBasicMemCtrl: flush the hart's write-combining buffer to the request queue
+  void flushWC(unsigned Hart);
+
+  /// RevBasicMemCtrl: flush every write-combining buffer that overlaps the target range
+  void flushWCLine(uint64_t Addr, uint32_t Size);
+
   /// RevBasicMemCtrl: determine if there are any pending AMOs that would prevent a request from dispatching
   bool isPendingAMO(unsigned Slot);
 
@@ -634,6 +679,11 @@ private:
   unsigned max_writeunlock;               ///< maximum number of oustanding writelock events
   unsigned max_custom;                    ///< maximum number of oustanding custom events
   unsigned max_ops;                       ///< maximum number of ops to issue per cycle
+  unsigned max_mshr;                      ///< maximum number of outstanding MSHR line fills
+  unsigned max_mshr_targets;              ///< maximum number of reads merged into an MSHR line fill
+  unsigned max_wc_stores;                 ///< maximum number of stores merged into a write-combining buffer
+  uint64_t wc_timeout;                    ///< idle cycles before a write-combining buffer is flushed
+  Cycle_t currentCycle;                   ///< current memory controller cycle
 
   uint64_t num_read;                      ///< number of outstanding read requests
   uint64_t num_write;                     ///< number of outstanding write requests
@@ -662,6 +712,23 @@ private:
                            RevMemOp *,
                            bool>> AMOTable;  ///< map of amo operations to memory addresses
 
+  std::unordered_map<uint64_t, StandardMem::Request::id_t> mshrOpen;          ///< cache lines accepting merged reads
+  std::map<StandardMem::Request::id_t, std::vector<RevMemOp *>> mshrTargets;  ///< outstanding MSHR line fills and their waiting reads
+
+  /// RevBasicMemCtrl: per-hart write-combining buffer
+  struct RevWCBuffer{
+    uint64_t Line = 0;                ///< RevWCBuffer: base address of the buffered cache line
+    uint64_t PLine = 0;               ///< RevWCBuffer: base physical address of the buffered cache line
+    RevFlag Flags = RevFlag::F_NONE;  ///< RevWCBuffer: flags shared by the buffered stores
+    unsigned Stores = 0;              ///< RevWCBuffer: number of stores merged into the buffer
+    unsigned ValidBytes = 0;          ///< RevWCBuffer: number of valid bytes in the buffer
+    Cycle_t LastWrite = 0;            ///< RevWCBuffer: cycle of the most recent merged store
+    std::vector<uint8_t> Data;        ///< RevWCBuffer: buffered line data
+    std::vector<bool> Valid;          ///< RevWCBuffer: byte valid mask
+  };
+
+  std::map<unsigned, RevWCBuffer> wcBuffers;  ///< write-combining buffers indexed by CPU-wide hart ID
+
   std::vector<Statistic<uint64_t>*> stats;  ///< statistics vector
 
 }; // RevBasicMemCtrl
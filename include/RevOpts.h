@@ -58,6 +58,15 @@ public:
   /// RevOpts: initialize the prefetch depths
   bool InitPrefetchDepth( std::vector<std::string> Depths );
 
+  /// RevOpts: initialize the load/store queue depths
+  bool InitLSQDepth( std::vector<std::string> Depths );
+
+  /// RevOpts: initialize the system call copy bandwidths
+  bool InitSyscallBandwidth( std::vector<std::string> Bandwidths );
+
+  /// RevOpts: initialize the set of system call cost tables
+  bool InitSyscallTables( std::vector<std::string> SyscallTables );
+
   /// RevOpts: retrieve the start address for the target core
   bool GetStartAddr( unsigned Core, uint64_t &StartAddr );
 
@@ -76,6 +85,15 @@ public:
   /// RevOpts: retrieve the prefetch depth for the target core
   bool GetPrefetchDepth( unsigned Core, unsigned &Depth );
 
+  /// RevOpts: retrieve the per-hart load/store queue depth for the target core
+  bool GetLSQDepth( unsigned Core, unsigned &Depth );
+
+  /// RevOpts: retrieve the system call copy bandwidth (bytes per cycle) for the target core
+  bool GetSyscallBandwidth( unsigned Core, unsigned &Bandwidth );
+
+  /// RevOpts: retrieve the system call cost table for the target core
+  bool GetSyscallTable( unsigned Core, std::string &Table );
+
   /// RevOpts: set the argv arrary
   void SetArgs(std::vector<std::string> A){ Argv = A; }
 
@@ -92,6 +110,9 @@ private:
   std::map<unsigned, std::string> machine;       ///< RevOpts: map of core id to machine model
   std::map<unsigned, std::string> table;         ///< RevOpts: map of core id to inst table
   std::map<unsigned, unsigned> prefetchDepth;    ///< RevOpts: map of core id to prefretch depth
+  std::map<unsigned, unsigned> lsqDepth;         ///< RevOpts: map of core id to load/store queue depth
+  std::map<unsigned, unsigned> syscallBW;        ///< RevOpts: map of core id to syscall copy bandwidth
+  std::map<unsigned, std::string> syscallTable;  ///< RevOpts: map of core id to syscall cost table
 
   std::vector<std::pair<unsigned, unsigned>> memCosts; ///< RevOpts: vector of memory cost ranges
 
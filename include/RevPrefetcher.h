@@ -30,7 +30,7 @@ public:
   /// RevPrefetcher: constructor
   RevPrefetcher(RevMem *Mem, RevFeature *Feature, unsigned Depth,
                 std::shared_ptr<std::unordered_multimap<uint64_t, MemReq>> lsq,
-                std::function<void(const MemReq&)> func)
+                MemReqCompletion func)
     : mem(Mem), feature(Feature), depth(Depth), LSQueue(lsq), MarkLoadAsComplete(func), OutstandingFetchQ(){}
 
   /// RevPrefetcher: destructor
@@ -52,7 +52,7 @@ private:
   std::vector<uint64_t> baseAddr;             ///< Vector of base addresses for each stream
   std::vector<std::vector<uint32_t>> iStack; ///< Vector of instruction vectors
   std::shared_ptr<std::unordered_multimap<uint64_t, MemReq>> LSQueue;
-  std::function<void(const MemReq&)> MarkLoadAsComplete;
+  MemReqCompletion MarkLoadAsComplete;
   std::vector<MemReq> OutstandingFetchQ;
 
   /// fills a missed stream cache instruction
@@ -29,6 +29,7 @@
 #include <memory>
 #include <queue>
 #include <string>
+#include <sys/uio.h>
 #include <sys/xattr.h>
 #include <time.h>
 #include <tuple>
@@ -50,6 +51,9 @@
 #include "RevRand.h"
 #include "RevProcPasskey.h"
 #include "RevHart.h"
+#include "RevAIO.h"
+#include "RevVFS.h"
+#include "RevReplay.h"
 #define SYSCALL_TYPES_ONLY
 #include "../common/syscalls/syscalls.h"
 #include "../common/include/RevCommon.h"
@@ -59,9 +63,16 @@ class RevCoProc;
 
 class RevProc{
 public:
+  /// RevProc: wakes up to NWake threads waiting on the futex at Addr whose
+  /// bitset intersects Bitset, then moves up to NRequeue of the remaining
+  /// waiters to Addr2.  Returns the number of threads woken or requeued
+  using FutexWakeFunc = std::function<uint64_t(uint64_t Addr, uint64_t NWake, uint32_t Bitset,
+                                               uint64_t Addr2, uint64_t NRequeue)>;
+
   /// RevProc: standard constructor
   RevProc( unsigned Id, RevOpts *Opts, unsigned NumHarts, RevMem *Mem, RevLoader *Loader,
-           std::function<uint32_t()> GetNewThreadID, SST::Output *Output );
+           std::function<uint32_t()> GetNewThreadID, FutexWakeFunc FutexWake,
+           SST::Output *Output );
 
   /// RevProc: standard destructor
   ~RevProc() = default;
@@ -87,6 +98,22 @@ public:
   /// RevProc: set time converter for RTC
   void SetTimeConverter(TimeConverter* tc) { timeConverter = tc; }
 
+  /// RevProc: set the asynchronous I/O engine
+  void SetAIO(RevAIO* a) { aio = a; }
+
+  /// RevProc: set the in-memory filesystem (nullptr uses the host filesystem)
+  void SetVFS(RevVFS* v) { vfs = v; }
+
+  /// RevProc: set the record/replay log of host inputs (nullptr disables it)
+  void SetReplay(RevReplay* r) { replay = r; }
+
+  /// RevProc: set the time slice (0 disables preemption) and the cycles a
+  ///          hart spends switching to another thread after a preemption
+  void SetTimeSlice(uint64_t Slice, uint64_t SwitchCost) { TimeSlice = Slice; ContextSwitchCost = SwitchCost; }
+
+  /// RevProc: set whether ready threads are waiting for a hart of this core
+  void SetThreadsWaiting(bool Waiting) { ThreadsWaiting = Waiting; }
+
   /// RevProc: Debug mode read a register
   bool DebugReadReg(unsigned Idx, uint64_t *Value) const;
 
@@ -114,6 +141,27 @@ public:
   /// RevProc: Handle ALU faults
   void InjectALUFault(std::pair<unsigned,unsigned> EToE, RevInst& Inst);
 
+  /// RevProc: per-system call profile
+  struct RevEcallProfile{
+    uint64_t Calls;                      ///< RevEcallProfile: completed calls
+    uint64_t Cycles;                     ///< RevEcallProfile: cycles from issue to completion
+    uint64_t Bytes;                      ///< RevEcallProfile: bytes copied to or from the host
+  };
+
+  /// RevProc: profile of each system call made since the last call; added to the totals
+  std::map<uint32_t, RevEcallProfile> GetAndClearEcallProfile(){
+    for( const auto& [Code, Prof] : EcallProfile ){
+      auto& Total = EcallProfileTotal[Code];
+      Total.Calls  += Prof.Calls;
+      Total.Cycles += Prof.Cycles;
+      Total.Bytes  += Prof.Bytes;
+    }
+    return std::exchange(EcallProfile, {});
+  }
+
+  /// RevProc: codes of the implemented system calls
+  static std::vector<uint32_t> GetEcallCodes();
+
   struct RevProcStats {
     uint64_t totalCycles;
     uint64_t cyclesBusy;
@@ -123,9 +171,27 @@ public:
     uint64_t cyclesIdle_Pipeline;
     uint64_t cyclesIdle_MemoryFetch;
     uint64_t retired;
+    uint64_t lsqForwards;
+    uint64_t lsqViolations;
+    uint64_t lsqFullStalls;
+    uint64_t cyclesStalled_LSQ;
+    uint64_t syscallsExec;
+    uint64_t cyclesSyscall;
+    uint64_t syscallBytes;
+    uint64_t preemptions;
+    uint64_t cyclesContextSwitch;
   };
 
   auto GetAndClearStats() {
+    // Collect the load/store queue counters from each hart
+    for( auto& Hart : Harts ){
+      RevLSQ *LSQ = Hart->GetLSQ();
+      Stats.lsqForwards       += LSQ->GetAndClearForwards();
+      Stats.lsqViolations     += LSQ->GetAndClearViolations();
+      Stats.lsqFullStalls     += LSQ->GetAndClearFullStalls();
+      Stats.cyclesStalled_LSQ += LSQ->GetAndClearFullStallCycles();
+    }
+
     // Add each field from Stats into StatsTotal
     for(auto stat : {
         &RevProcStats::totalCycles,
@@ -134,7 +200,16 @@ public:
         &RevProcStats::cyclesStalled,
         &RevProcStats::floatsExec,
         &RevProcStats::cyclesIdle_Pipeline,
-        &RevProcStats::retired}){
+        &RevProcStats::retired,
+        &RevProcStats::lsqForwards,
+        &RevProcStats::lsqViolations,
+        &RevProcStats::lsqFullStalls,
+        &RevProcStats::cyclesStalled_LSQ,
+        &RevProcStats::syscallsExec,
+        &RevProcStats::cyclesSyscall,
+        &RevProcStats::syscallBytes,
+        &RevProcStats::preemptions,
+        &RevProcStats::cyclesContextSwitch}){
       StatsTotal.*stat += Stats.*stat;
     }
 
@@ -159,6 +234,9 @@ public:
   ///< RevProc: SpawnThread creates a new thread and returns its ThreadID
   void CreateThread(uint32_t NewTid, uint64_t fn, void* arg);
 
+  ///< RevProc: Return the register file of a reclaimed thread for reuse by CreateThread
+  void RecycleRegFile(std::unique_ptr<RevRegFile> RegFile);
+
   ///< RevProc: Returns the current HartToExecID active pid
   uint32_t GetActiveThreadID(){ return Harts.at(HartToDecodeID)->GetAssignedThreadID(); }
 
@@ -217,8 +295,17 @@ public:
   ///< RevProc:
   void UpdateStatusOfHarts();
 
-  ///< RevProc: Returns the id of an idle hart (or _INVALID_HART_ID_ if none are idle)
-  unsigned FindIdleHartID() const ;
+  ///< RevProc: Returns the id of an idle hart Thread may run on (any idle hart if Thread is null)
+  unsigned FindIdleHartID(const RevThread* Thread = nullptr) const;
+
+  ///< RevProc: Returns true if Thread may run on one of the idle harts
+  bool HasIdleHartFor(const RevThread& Thread) const;
+
+  ///< RevProc: Returns true if the affinity of Thread allows any hart of this core
+  bool AllowsThread(const RevThread& Thread) const;
+
+  ///< RevProc: Returns the CPU number of hart HartID used in affinity masks
+  unsigned GetCPU(unsigned HartID) const { return id * numHarts + HartID; }
 
   ///< RevProc: Returns true if all harts are available (ie. There is nothing executing on this Proc)
   bool HasNoBusyHarts() const { return IdleHarts == ValidHarts; }
@@ -231,6 +318,9 @@ public:
   ///< RevProc: Returns true if there are any IdleHarts
   bool HasIdleHart() const { return IdleHarts.any(); }
 
+  ///< RevProc: Returns the number of harts with a thread assigned
+  unsigned GetNumBusyHarts() const { return (ValidHarts & ~IdleHarts).count(); }
+
 private:
   bool Halted;              ///< RevProc: determines if the core is halted
   bool Stalled;             ///< RevProc: determines if the core is stalled on instruction fetch
@@ -258,6 +348,22 @@ private:
   // Function pointer to the GetNewThreadID function in RevCPU (monotonically increasing thread ID counter)
   std::function<uint32_t()> GetNewThreadID;
 
+  // Function pointer to the futex wait queues in RevCPU
+  FutexWakeFunc FutexWake;
+
+  // Register files of reclaimed threads, reused for new threads
+  std::vector<std::unique_ptr<RevRegFile>> RegFilePool;
+
+  // Register files of reclaimed threads that still have loads in flight;
+  // each is recycled once its last load completes
+  std::vector<std::unique_ptr<RevRegFile>> RetiringRegFiles;
+
+  /// RevProc: determines whether any load in the LSQ still targets RF
+  bool HasLoadsInFlight(const RevRegFile* RF) const;
+
+  /// RevProc: recycle RF from RetiringRegFiles once its loads have completed
+  void RetireRegFile(const RevRegFile* RF);
+
   // If a given assigned thread experiences a change of state, it sets the corresponding bit
   std::vector<std::unique_ptr<RevThread>> ThreadsThatChangedState; ///< RevProc: used to signal to RevCPU that the thread assigned to HART has changed state
 
@@ -269,7 +375,25 @@ private:
   std::unique_ptr<RevPrefetcher> sfetch; ///< RevProc: stream instruction prefetcher
 
   std::shared_ptr<std::unordered_multimap<uint64_t, MemReq>> LSQueue; ///< RevProc: Load / Store queue used to track memory operations. Currently only tracks outstanding loads.
+  MemReqCompletion MarkLoadCompleteFunc{}; ///< RevProc: completion handle attached to this core's memory requests
+  unsigned EcallBandwidth = 0;           ///< RevProc: bytes per cycle copied by system calls (0 is free)
+  uint64_t TimeSlice = 0;                ///< RevProc: cycles a thread runs before it may be preempted (0 never)
+  uint64_t ContextSwitchCost = 0;        ///< RevProc: cycles a hart stalls after a preemption
+  bool ThreadsWaiting = false;           ///< RevProc: ready threads are queued for this core
+
+  /// RevProc: simulated cost of a system call, replacing EcallBandwidth
+  struct RevEcallCost{
+    uint64_t Fixed;                      ///< RevEcallCost: cycles charged per call
+    double PerByte;                      ///< RevEcallCost: cycles charged per byte copied
+  };
+
+  std::unordered_map<uint32_t, RevEcallCost> EcallCosts{};  ///< RevProc: user-defined system call costs
+  std::map<uint32_t, RevEcallProfile> EcallProfile{};       ///< RevProc: profile of each system call since the last statistics update
+  std::map<uint32_t, RevEcallProfile> EcallProfileTotal{};  ///< RevProc: profile of each system call made
   TimeConverter* timeConverter;          ///< RevProc: Time converter for RTC
+  RevAIO* aio = nullptr;                 ///< RevProc: asynchronous I/O engine
+  RevVFS* vfs = nullptr;                 ///< RevProc: in-memory filesystem, if enabled
+  RevReplay* replay = nullptr;           ///< RevProc: record/replay log of host inputs, if enabled
 
   RevRegFile* RegFile = nullptr; ///< RevProc: Initial pointer to HartToDecodeID RegFile
   uint32_t ActiveThreadID = _INVALID_TID_; ///< Software ThreadID (Not the Hart) that belongs to the Hart currently decoding
@@ -280,6 +404,66 @@ private:
   ///< RevProc: Utility function for system calls that involve reading a string from memory
   EcallStatus EcallLoadAndParseString(RevInst& inst, uint64_t straddr, std::function<void()>);
 
+  ///< RevProc: Charge the simulated cost of copying Bytes between guest memory and the host
+  void ChargeEcallBytes(uint64_t Bytes);
+
+  ///< RevProc: Make a host call for the current ECALL, or replay its logged result and Data
+  int64_t EcallHost(const std::function<int64_t()>& Call, std::vector<char>* Data = nullptr);
+
+  ///< RevProc: Retrieve the simulated cost in cycles of system call Code having copied Bytes
+  uint64_t EcallCost(uint32_t Code, uint64_t Bytes) const;
+
+  ///< RevProc: Utility function for system calls that read a fixed-size buffer from memory through memHierarchy
+  EcallStatus EcallLoadBuffer(uint64_t addr, uint64_t nbytes, std::function<void()>);
+
+  ///< RevProc: Translate a guest address range into host iovecs pointing into RevMem pages
+  bool EcallHostIovecs(uint64_t Addr, uint64_t Len, std::vector<iovec>& Iov);
+
+  ///< RevProc: Copy Len bytes of guest memory at Addr into Dst without going through the memory hierarchy
+  bool EcallCopyFromGuest(uint64_t Addr, void *Dst, size_t Len);
+
+  ///< RevProc: Translate a guest iovec array into host iovecs; returns the total length or a negative errno.
+  ///< The guest buffers are also returned in Bufs if it is given
+  ssize_t EcallGuestIovecs(uint64_t VecAddr, uint64_t VLen, std::vector<iovec>& Iov,
+                           std::vector<std::pair<uint64_t, uint64_t>>* Bufs = nullptr);
+
+  ///< RevProc: Revoke the reservations on the guest buffers filled by a direct host read of Len bytes
+  void EcallRevokeFutures(const std::vector<std::pair<uint64_t, uint64_t>>& Bufs, ssize_t Len);
+
+  ///< RevProc: Read Len bytes of guest memory at Addr and call action() with them
+  EcallStatus EcallLoadGuest(uint64_t Addr, size_t Len, std::function<void(const char*)> action);
+
+  ///< RevProc: Deschedule the active thread until the futex at Addr is woken or Timeout cycles pass
+  void FutexBlock(uint64_t Addr, uint32_t Bitset, uint64_t Timeout = UINT64_MAX);
+
+  ///< RevProc: Deschedule the active thread for Cycles cycles (0 yields, UINT64_MAX sleeps until woken)
+  void EcallSleep(uint64_t Cycles);
+
+  ///< RevProc: Create a thread sharing the active thread's address space (clone/clone3)
+  EcallStatus EcallClone(uint64_t Flags, uint64_t NewSP, uint64_t ParentTID,
+                         uint64_t TLS, uint64_t ChildTID);
+
+  ///< RevProc: Zero and futex-wake the child tid of a thread that is exiting
+  void ClearChildTID(const RevThread& Thread, unsigned HartID);
+
+  ///< RevProc: Convert a duration in nanoseconds to cycles of this core's clock
+  uint64_t EcallNanosToCycles(uint64_t Nanos) const;
+
+  ///< RevProc: Read the current time in nanoseconds as reported by clock_gettime
+  uint64_t EcallNowNanos() const;
+
+  ///< RevProc: Retrieve a 64-bit file offset argument split across Lo and Hi on RV32
+  off_t EcallOffset(RevReg Lo, RevReg Hi);
+
+  ///< RevProc: Perform a host writev/readv (pwritev/preadv when Pos is non-null) of Iov
+  ssize_t EcallHostIO(bool Write, int fd, const std::vector<iovec>& Iov, const off_t *Pos);
+
+  ///< RevProc: Read from a host file descriptor directly into the guest pages backing Addr
+  ssize_t EcallReadInto(int fd, uint64_t Addr, uint64_t Len, const off_t *Pos);
+
+  ///< RevProc: Read from a host file descriptor into guest memory through RevMem::WriteMem
+  ssize_t EcallStagedRead(int fd, uint64_t Addr, uint64_t Len, const off_t *Pos);
+
   // - Many of these are not implemented
   // - Their existence in the ECalls table is solely to not throw errors
   // - This _should_ be a comprehensive list of system calls supported on RISC-V
@@ -602,17 +786,33 @@ private:
   // =============== REV specific functions
   EcallStatus ECALL_cpuinfo(RevInst& inst);                // 500, rev_cpuinfo(struct rev_cpuinfo *info);
   EcallStatus ECALL_perf_stats(RevInst& inst);             // 501, rev_perf_stats(struct rev_stats *stats);
+  EcallStatus ECALL_trace_dump(RevInst& inst);             // 502, rev_trace_dump();
 
   // =============== REV pthread functions
   EcallStatus ECALL_pthread_create(RevInst& inst);         // 1000, rev_pthread_create(pthread_t *thread, const pthread_attr_t  *attr, void  *(*start_routine)(void  *), void  *arg)
   EcallStatus ECALL_pthread_join(RevInst& inst);           // 1001, rev_pthread_join(pthread_t thread, void **retval);
   EcallStatus ECALL_pthread_exit(RevInst& inst);           // 1002, rev_pthread_exit(void* retval);
 
-  /// RevProc: Table of ecall codes w/ corresponding function pointer implementations
-  std::unordered_map<uint32_t, std::function<EcallStatus(RevProc*, RevInst&)>> Ecalls;
+  /// RevProc: ecall implementation
+  using EcallHandler = EcallStatus (RevProc::*)(RevInst&);
+
+  /// RevProc: ecall code paired with its implementation
+  struct EcallEntry{
+    uint32_t Code;          ///< EcallEntry: ecall code loaded in a7
+    EcallHandler Handler;   ///< EcallEntry: ecall implementation
+  };
+
+  /// RevProc: ecall codes below this are dispatched through EcallTable
+  static constexpr uint32_t EcallTableSize = 512;
 
-  /// RevProc: Initialize all of the ecalls inside the above table
-  void InitEcallTable();
+  /// RevProc: Table of ecall codes w/ corresponding implementations, sorted by code
+  static const EcallEntry EcallList[];
+
+  /// RevProc: EcallList flattened into a table indexed by ecall code; shared by all cores
+  static const std::array<EcallHandler, EcallTableSize> EcallTable;
+
+  /// RevProc: Retrieve the implementation of ecall Code, or nullptr if there is none
+  static EcallHandler GetEcallHandler(uint64_t Code);
 
   /// RevProc: Execute the Ecall based on the code loaded in RegFile->RV64_SCAUSE
   void ExecEcall(RevInst &inst);
@@ -655,6 +855,9 @@ private:
   /// RevProc: read in the user defined cost tables
   bool ReadOverrideTables();
 
+  /// RevProc: read in the user defined system call cost table
+  bool ReadSyscallTable();
+
   /// RevProc: compresses the encoding structure to a single value
   uint32_t CompressEncoding(RevInstEntry Entry);
 
@@ -760,8 +963,7 @@ private:
   /// RevProc: Check LS queue for outstanding load - ignore r0
   bool LSQCheck(unsigned HartID, const RevRegFile* regFile,
                 uint16_t reg, RevRegClass regClass) const {
-    return (reg != 0 || regClass != RevRegClass::RegGPR) &&
-      regFile->GetLSQueue()->count(LSQHash(reg, regClass, HartID)) > 0;
+    return regFile->HasPendingLoad(reg, regClass);
   }
 
   /// RevProc: Check scoreboard for a source register dependency
@@ -778,6 +980,9 @@ private:
   ///< Removes thread from Hart and returns it
   std::unique_ptr<RevThread> PopThreadFromHart(unsigned HartID);
 
+  /// RevProc: Return the thread of a hart whose time slice expired to RevCPU
+  void PreemptExpiredHart();
+
   /// RevProc: Check scoreboard for pipeline hazards
   bool DependencyCheck(unsigned HartID, const RevInst* Inst) const;
 
@@ -798,8 +1003,14 @@ private:
   template<typename T>
   void DependencySet(unsigned HartID, T RegNum,
                      bool isFloat, bool value = true){
+    DependencySet(GetRegFile(HartID), RegNum, isFloat, value);
+  }
+
+  /// RevProc: Set or clear the scoreboard of a register file, which need not be on a hart
+  template<typename T>
+  static void DependencySet(RevRegFile* regFile, T RegNum,
+                            bool isFloat, bool value = true){
     if( size_t(RegNum) < _REV_NUM_REGS_ ){
-      RevRegFile* regFile = GetRegFile(HartID);
       if(isFloat){
         regFile->FP_Scoreboard[size_t(RegNum)] = value;
       }else if( size_t(RegNum) != 0 ){
@@ -814,6 +1025,12 @@ private:
     DependencySet(HartID, RegNum, isFloat, false);
   }
 
+  /// RevProc: Clear the scoreboard of a register file, which need not be on a hart
+  template<typename T>
+  static void DependencyClear(RevRegFile* regFile, T RegNum, bool isFloat){
+    DependencySet(regFile, RegNum, isFloat, false);
+  }
+
 }; // class RevProc
 
 } // namespace SST::RevCPU
@@ -11,12 +11,14 @@
 #ifndef _SST_REVCPU_REVREGFILE_H_
 #define _SST_REVCPU_REVREGFILE_H_
 
+#include <algorithm>
 #include <bitset>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <functional>
+#include <iterator>
 #include <memory>
 #include <ostream>
 #include <type_traits>
@@ -24,6 +26,7 @@
 #include <utility>
 
 #include "RevFeature.h"
+#include "RevLSQ.h"
 #include "RevMem.h"
 #include "../common/include/RevCommon.h"
 
@@ -93,7 +96,8 @@ private:
   FCSR fcsr{}; ///< RevRegFile: FCSR
 
   std::shared_ptr<std::unordered_multimap<uint64_t, MemReq>> LSQueue{};
-  std::function<void(const MemReq&)> MarkLoadCompleteFunc{};
+  MemReqCompletion MarkLoadCompleteFunc{};
+  RevLSQ *LSQ = nullptr;              ///< RevRegFile: Load/store queue of the executing hart
 
   union{  // Anonymous union. We zero-initialize the largest member
     uint32_t RV32[_REV_NUM_REGS_];      ///< RevRegFile: RV32I register file
@@ -108,6 +112,11 @@ private:
   std::bitset<_REV_NUM_REGS_> RV_Scoreboard{}; ///< RevRegFile: Scoreboard for RV32/RV64 RF to manage pipeline hazard
   std::bitset<_REV_NUM_REGS_> FP_Scoreboard{}; ///< RevRegFile: Scoreboard for SPF/DPF RF to manage pipeline hazard
 
+  std::bitset<_REV_NUM_REGS_> RV_PendingLoads{}; ///< RevRegFile: RV32/RV64 registers with a load outstanding in the LSQueue
+  std::bitset<_REV_NUM_REGS_> FP_PendingLoads{}; ///< RevRegFile: SPF/DPF registers with a load outstanding in the LSQueue
+  uint16_t RV_PendingCount[_REV_NUM_REGS_]{};    ///< RevRegFile: Number of outstanding loads per RV32/RV64 register
+  uint16_t FP_PendingCount[_REV_NUM_REGS_]{};    ///< RevRegFile: Number of outstanding loads per SPF/DPF register
+
   // Supervisor Mode CSRs
 #if 0 // not used
   union{  // Anonymous union. We zero-initialize the largest member
@@ -138,12 +147,53 @@ private:
   };
 #endif
 
+  /// Outstanding load counter for a register; x0 and non-register classes are not tracked
+  uint16_t* PendingCount(uint16_t reg, RevRegClass regClass){
+    if( reg >= _REV_NUM_REGS_ )
+      return nullptr;
+    if( regClass == RevRegClass::RegFLOAT )
+      return &FP_PendingCount[reg];
+    if( regClass == RevRegClass::RegGPR && reg != 0 )
+      return &RV_PendingCount[reg];
+    return nullptr;
+  }
+
+  /// Pending load bitmask for a register class
+  std::bitset<_REV_NUM_REGS_>& PendingLoads(RevRegClass regClass){
+    return regClass == RevRegClass::RegFLOAT ? FP_PendingLoads : RV_PendingLoads;
+  }
+
 public:
   // Constructor which takes a RevFeature
   explicit RevRegFile(const RevFeature* feature)
     : IsRV32(feature->IsRV32()), HasD(feature->HasD()) {
   }
 
+  /// Return the register file to its freshly constructed state so it can be
+  /// reused by another thread
+  void Reset(){
+    trigger = false;
+    Entry   = 0;
+    cost    = 0;
+    Tracer  = nullptr;
+    RV64_PC = 0;
+    fcsr    = {};
+    LSQueue.reset();
+    MarkLoadCompleteFunc = {};
+    LSQ = nullptr;
+    std::fill(std::begin(RV64), std::end(RV64), 0);
+    std::fill(std::begin(DPF), std::end(DPF), 0.0);
+    RV_Scoreboard.reset();
+    FP_Scoreboard.reset();
+    RV_PendingLoads.reset();
+    FP_PendingLoads.reset();
+    std::fill(std::begin(RV_PendingCount), std::end(RV_PendingCount), 0);
+    std::fill(std::begin(FP_PendingCount), std::end(FP_PendingCount), 0);
+    RV64_SEPC   = 0;
+    RV64_SCAUSE = 0;
+    RV64_STVAL  = 0;
+  }
+
   // Getters/Setters
 
   /// Get cost of the instruction
@@ -173,17 +223,54 @@ public:
     LSQueue = std::move(lsq);
   }
 
+  /// Insert an outstanding load into the LSQueue and mark its destination register pending.
+  /// The request is stamped with this register file as its owner.
+  void LSQInsert(MemReq& req){
+    req.RegFile = this;
+    LSQueue->insert(req.LSQHashPair());
+    if( uint16_t *Count = PendingCount(req.DestReg, req.RegType) ){
+      if( (*Count)++ == 0 )
+        PendingLoads(req.RegType).set(req.DestReg);
+    }
+  }
+
+  /// Release the destination register of a completed load.  Returns true if
+  /// this was the last outstanding load for the register
+  bool ClearPendingLoad(const MemReq& req){
+    uint16_t *Count = PendingCount(req.DestReg, req.RegType);
+    if( !Count || *Count == 0 )
+      return true;
+    if( --(*Count) == 0 ){
+      PendingLoads(req.RegType).reset(req.DestReg);
+      return true;
+    }
+    return false;
+  }
+
+  /// Whether a load is outstanding for the target register
+  bool HasPendingLoad(uint64_t reg, RevRegClass regClass) const {
+    return reg < _REV_NUM_REGS_ &&
+      ( (regClass == RevRegClass::RegFLOAT && FP_PendingLoads[reg]) ||
+        (regClass == RevRegClass::RegGPR && RV_PendingLoads[reg]) );
+  }
+
+  /// Get the hart's load/store queue
+  RevLSQ* GetLSQ() const { return LSQ; }
+
+  /// Set the hart's load/store queue
+  void SetLSQ(RevLSQ *lsq) { LSQ = lsq; }
+
   /// Set the current tracer
   void SetTracer(RevTracer *t) { Tracer = t; }
 
   /// Get the MarkLoadComplete function
-  const std::function<void(const MemReq&)>& GetMarkLoadComplete() const {
+  MemReqCompletion GetMarkLoadComplete() const {
     return MarkLoadCompleteFunc;
   }
 
   /// Set the MarkLoadComplete function
-  void SetMarkLoadComplete(std::function<void(const MemReq&)> func){
-    MarkLoadCompleteFunc = std::move(func);
+  void SetMarkLoadComplete(MemReqCompletion func){
+    MarkLoadCompleteFunc = func;
   }
 
   /// Invoke the MarkLoadComplete function
@@ -0,0 +1,91 @@
+//
+// _RevReplay_h_
+//
+// Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _SST_REVCPU_REVREPLAY_H_
+#define _SST_REVCPU_REVREPLAY_H_
+
+// -- Standard Headers
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace SST::RevCPU{
+
+/*! \class RevReplay
+ *  \brief Record/replay log of nondeterministic host inputs
+ *
+ * In record mode every result the simulator obtains from the host on
+ * behalf of the guest (system call return values along with the bytes they
+ * produce, and random draws such as new thread IDs) is appended to a
+ * binary log.  In replay mode the same events are read back in the same
+ * order instead of touching the host, so a replayed run is bit-identical
+ * to the recorded one and performs no host I/O.
+ *
+ * The log is an 8 byte magic followed by one record per event: the event
+ * type byte, then the event code, the zigzag-encoded value and the data
+ * length as LEB128 varints, then the data bytes.  Each record carries its
+ * type and code (the system call number for syscalls) so a replay that
+ * diverges from the recording is detected at the first mismatch.
+ */
+class RevReplay{
+public:
+  /// RevReplay: kind of event logged
+  enum class Event : uint8_t {
+    Syscall = 1,    ///< RevReplay: host system call result
+    Random  = 2,    ///< RevReplay: random draw
+  };
+
+  /// RevReplay: constructor; opens Path for writing, or for reading when Replaying
+  RevReplay(const std::string& Path, bool Replaying);
+
+  /// RevReplay: destructor
+  ~RevReplay() = default;
+
+  /// RevReplay: disallow copying and assignment
+  RevReplay(const RevReplay&) = delete;
+  RevReplay& operator=(const RevReplay&) = delete;
+
+  /// RevReplay: determines whether the log was opened (and has a valid header)
+  bool IsOpen() const { return Good; }
+
+  /// RevReplay: determines whether events are read back from the log
+  bool IsReplaying() const { return Replaying; }
+
+  /// RevReplay: retrieve the number of events logged or replayed so far
+  uint64_t GetCount() const { return Count; }
+
+  /// RevReplay: record an event with its value and Len bytes of Data
+  void Put(Event E, uint64_t Code, int64_t Value, const void *Data = nullptr, size_t Len = 0);
+
+  /// RevReplay: replay the next event, which must match E and Code.  Its
+  /// data is stored in Data when non-null.  Returns false on a mismatch or
+  /// at the end of the log
+  bool Get(Event E, uint64_t Code, int64_t& Value, std::vector<char> *Data = nullptr);
+
+private:
+  /// RevReplay: write an unsigned LEB128 varint
+  void PutVarint(uint64_t V);
+
+  /// RevReplay: read an unsigned LEB128 varint
+  bool GetVarint(uint64_t& V);
+
+  static constexpr char Magic[8] = {'R','E','V','R','P','L','Y','1'};  ///< RevReplay: log header
+
+  bool Replaying;         ///< RevReplay: events are read back from the log
+  bool Good = false;      ///< RevReplay: the log is usable
+  uint64_t Count = 0;     ///< RevReplay: events processed
+  std::ofstream Out{};    ///< RevReplay: log being recorded
+  std::ifstream In{};     ///< RevReplay: log being replayed
+};
+
+} // namespace SST::RevCPU
+
+#endif // _SST_REVCPU_REVREPLAY_H_
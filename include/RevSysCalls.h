@@ -36,11 +36,19 @@ struct EcallState {
   std::string string;
   std::string path_string;
   size_t bytesRead = 0;
-
+  uint64_t stallCycles = 0;   ///< simulated cycles remaining once the host call has completed
+  uint64_t deadline = 0;      ///< cycle a blocking call gives up at (0 until it starts waiting)
+  uint64_t bytesMoved = 0;    ///< bytes copied between guest memory and the host by this call
+  uint64_t startCycle = 0;    ///< core cycle the call was first issued at
+  bool inFlight = false;      ///< the call has been issued but has not completed
+
+  // stallCycles and the accounting fields are owned by RevProc::ExecEcall
+  // and are not reset here
   void clear(){
     string.clear();
     path_string.clear();
     bytesRead = 0;
+    deadline = 0;
     buf[0] = '\0';
   }
   EcallState() {
@@ -38,7 +38,9 @@ public:
   ///< RevThread: Destructor
   ~RevThread(){
     // Check if any fildes are still open
-    // and close them if so
+    // and close them if so (replayed fildes were never opened on the host)
+    if( !CloseFDs )
+      return;
     for(auto fd : fildes){
       if(fd > 2){
        close(fd);
@@ -64,6 +66,78 @@ public:
   ///< RevThread: Set the TID of the thread that this thread is waiting to join
   void SetWaitingToJoinTID(const uint32_t ThreadToWaitOn) { WaitingToJoinTID = ThreadToWaitOn; }
 
+  ///< RevThread: Get the address of the futex this thread is waiting on (0 if none)
+  uint64_t GetFutexAddr() const { return FutexAddr; }
+
+  ///< RevThread: Get the FUTEX_WAIT_BITSET mask this thread is waiting with
+  uint32_t GetFutexBitset() const { return FutexBitset; }
+
+  ///< RevThread: Set the futex this thread is waiting on
+  void SetFutexWait(uint64_t Addr, uint32_t Bitset){ FutexAddr = Addr; FutexBitset = Bitset; }
+
+  ///< RevThread: Deschedule this thread for Cycles cycles once it blocks
+  ///             (0 yields the hart, UINT64_MAX sleeps until woken)
+  void SetSleep(uint64_t Cycles){ Sleeping = true; SleepCycles = Cycles; }
+
+  ///< RevThread: Cancel a pending sleep
+  void ClearSleep(){ Sleeping = false; SleepCycles = 0; WakeCycle = 0; }
+
+  ///< RevThread: Is this thread sleeping (or waiting with a timeout)
+  bool IsSleeping() const { return Sleeping; }
+
+  ///< RevThread: Get the number of cycles this thread sleeps for
+  uint64_t GetSleepCycles() const { return SleepCycles; }
+
+  ///< RevThread: Get the cycle this thread is due to wake at
+  uint64_t GetWakeCycle() const { return WakeCycle; }
+
+  ///< RevThread: Set the cycle this thread is due to wake at
+  void SetWakeCycle(uint64_t Cycle){ WakeCycle = Cycle; }
+
+  ///< RevThread: Get the memory segment holding this thread's stack and TLS
+  const std::shared_ptr<RevMem::MemSegment>& GetThreadMem() const { return ThreadMem; }
+
+  ///< RevThread: Get the register state of a thread that is not loaded on a hart
+  RevVirtRegState* GetVirtRegState() const { return VirtRegState.get(); }
+
+  ///< RevThread: Get the cycle at which this thread blocked
+  uint64_t GetBlockedCycle() const { return BlockedCycle; }
+
+  ///< RevThread: Set the cycle at which this thread blocked
+  void SetBlockedCycle(uint64_t Cycle){ BlockedCycle = Cycle; }
+
+  ///< RevThread: Get the core this thread last ran on (_REV_INVALID_CORE_ID_ if it never ran)
+  unsigned GetLastCore() const { return LastCore; }
+
+  ///< RevThread: Set the core this thread last ran on
+  void SetLastCore(unsigned Core){ LastCore = Core; }
+
+  ///< RevThread: Get the CPU affinity mask (empty if the thread may run anywhere)
+  const std::vector<uint64_t>& GetAffinity() const { return Affinity; }
+
+  ///< RevThread: Set the CPU affinity mask; bit N of the mask allows
+  ///             CPU N, which is hart N % numHarts of core N / numHarts
+  void SetAffinity(std::vector<uint64_t> Mask){ Affinity = std::move(Mask); }
+
+  ///< RevThread: Can this thread run on CPU
+  bool CanRunOn(unsigned CPU) const {
+    return Affinity.empty() ||
+      ( CPU / 64 < Affinity.size() && (Affinity[CPU / 64] >> (CPU % 64) & 1) );
+  }
+
+  ///< RevThread: Is this thread reclaimed as soon as it completes (it is never joined)
+  bool IsDetached() const { return Detached; }
+
+  ///< RevThread: Set whether this thread is reclaimed as soon as it completes
+  void SetDetached(bool D){ Detached = D; }
+
+  ///< RevThread: Get the address zeroed and futex-woken when this thread exits (0 if none)
+  uint64_t GetClearChildTID() const { return ClearChildTID; }
+
+  ///< RevThread: Set the address zeroed and futex-woken when this thread exits
+  ///             (CLONE_CHILD_CLEARTID / set_tid_address)
+  void SetClearChildTID(uint64_t Addr){ ClearChildTID = Addr; }
+
   ///< RevThread: Add new file descriptor to this thread (ie. rev_open)
   void AddFD(int fd){ fildes.insert(fd); }
 
@@ -73,6 +147,9 @@ public:
   ///< See if file descriptor exists/is owned by this thread
   bool FindFD(int fd){ return fildes.count(fd); }
 
+  ///< RevThread: Set whether open fildes are closed on the host when the thread is destroyed
+  void SetCloseFDs(bool Close){ CloseFDs = Close; }
+
   ///< RevThread: Get the fildes valid for this thread
   const std::unordered_set<int>& GetFildes(){ return fildes; }
 
@@ -124,10 +201,22 @@ private:
   std::unique_ptr<RevVirtRegState> VirtRegState;       // Register file
   std::unordered_set<uint32_t> ChildrenIDs = {};       // Child thread IDs
   std::unordered_set<int> fildes = {0, 1, 2};          // Default file descriptors
+  bool CloseFDs = true;                                // Close fildes on the host at destruction
 
   ///< RevThread: ID of the thread this thread is waiting to join
   uint32_t WaitingToJoinTID = _INVALID_TID_;
 
+  uint64_t FutexAddr = 0;                              // Futex this thread is waiting on
+  uint32_t FutexBitset = 0;                            // FUTEX_WAIT_BITSET mask
+  uint64_t BlockedCycle = 0;                           // Cycle this thread blocked at
+  bool Sleeping = false;                               // Descheduled until WakeCycle
+  uint64_t SleepCycles = 0;                            // Requested sleep duration
+  uint64_t WakeCycle = 0;                              // Cycle this thread wakes at
+  unsigned LastCore = _REV_INVALID_CORE_ID_;           // Core this thread last ran on
+  std::vector<uint64_t> Affinity = {};                 // CPUs this thread may run on (empty is all)
+  bool Detached = false;                               // Reclaimed without being joined
+  uint64_t ClearChildTID = 0;                          // Cleared and woken at exit
+
 }; // class RevThread
 
 } // namespace SST::RevCPU
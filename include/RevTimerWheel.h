@@ -0,0 +1,95 @@
+//
+// _RevTimerWheel_h_
+//
+// Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _SST_REVCPU_REVTIMERWHEEL_H_
+#define _SST_REVCPU_REVTIMERWHEEL_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace SST::RevCPU{
+
+/*! \class RevTimerWheel
+ *  \brief Hashed timer wheel keyed on simulated cycles
+ *
+ * Each timer is hashed into the slot for its expiration cycle modulo the
+ * number of slots.  Advancing the wheel visits only the slots for the
+ * cycles that have elapsed, so the per-cycle cost is independent of the
+ * number of pending timers; timers more than one revolution away simply
+ * stay in their slot until their cycle comes around.
+ */
+class RevTimerWheel{
+public:
+  /// RevTimerWheel: constructor; Slots is rounded up to a power of two
+  explicit RevTimerWheel(unsigned Slots = 256){
+    unsigned N = 1;
+    while( N < Slots )
+      N <<= 1;
+    Wheel.resize(N);
+  }
+
+  /// RevTimerWheel: determines whether any timers are pending
+  bool Empty() const { return Pending == 0; }
+
+  /// RevTimerWheel: retrieve the number of pending timers
+  size_t Size() const { return Pending; }
+
+  /// RevTimerWheel: schedule ID to expire at Cycle
+  void Schedule(uint64_t Cycle, uint32_t ID){
+    // timers in the past expire on the next advance
+    if( Cycle <= Now )
+      Cycle = Now + 1;
+    Wheel[Cycle & (Wheel.size() - 1)].push_back({Cycle, ID});
+    Pending++;
+  }
+
+  /// RevTimerWheel: advance the wheel to Cycle, calling Expire(ID, When)
+  /// for every timer whose expiration cycle has been reached
+  template<typename F>
+  void Advance(uint64_t Cycle, F&& Expire){
+    if( Cycle <= Now )
+      return;
+    if( Pending ){
+      // visit each elapsed slot once, even when more than a revolution passed
+      uint64_t Span = std::min<uint64_t>(Cycle - Now, Wheel.size());
+      for( uint64_t c = Cycle - Span + 1; c <= Cycle; c++ ){
+        auto& Slot = Wheel[c & (Wheel.size() - 1)];
+        for( size_t i = 0; i < Slot.size(); ){
+          if( Slot[i].Cycle <= Cycle ){
+            Timer T = Slot[i];
+            Slot[i] = Slot.back();
+            Slot.pop_back();
+            Pending--;
+            Expire(T.ID, T.Cycle);
+          }else{
+            i++;
+          }
+        }
+      }
+    }
+    Now = Cycle;
+  }
+
+private:
+  /// RevTimerWheel: pending timer
+  struct Timer{
+    uint64_t Cycle;   ///< Timer: expiration cycle
+    uint32_t ID;      ///< Timer: identifier passed back on expiration
+  };
+
+  std::vector<std::vector<Timer>> Wheel{};  ///< RevTimerWheel: timer slots
+  uint64_t Now = 0;                         ///< RevTimerWheel: last cycle advanced to
+  size_t Pending = 0;                       ///< RevTimerWheel: number of pending timers
+};
+
+} // namespace SST::RevCPU
+
+#endif // _SST_REVCPU_REVTIMERWHEEL_H_
@@ -0,0 +1,134 @@
+//
+// _RevTraceFile_h_
+//
+// Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _SST_REVCPU_REVTRACEFILE_H_
+#define _SST_REVCPU_REVTRACEFILE_H_
+
+// -- Standard Headers
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace SST::RevCPU{
+
+/// RevTraceFile: one fixed width record of the binary trace (little endian)
+struct TraceFileRec{
+  uint8_t  Kind;    ///< TraceFileRec: RevTraceFile::Kind
+  uint8_t  Flag;    ///< TraceFileRec: kind specific flag
+  uint16_t Reg;     ///< TraceFileRec: register or hart
+  uint32_t Aux;     ///< TraceFileRec: length or string id
+  uint64_t A;       ///< TraceFileRec: kind specific field
+  uint64_t B;       ///< TraceFileRec: kind specific field
+  uint64_t C;       ///< TraceFileRec: kind specific field
+};
+static_assert(sizeof(TraceFileRec) == 32, "TraceFileRec must stay 32 bytes");
+
+/*! \class RevTraceFile
+ *  \brief Compact binary sink for the instruction trace of one core
+ *
+ * Every traced instruction and each of its effects is written as one
+ * TraceFileRec instead of a formatted line.  Fields that change little from
+ * one record to the next are stored as differences: the cycle, PC and memory
+ * address against the previous record (zigzag encoded), register values
+ * xor-ed with the last value seen for the same register.  Most of the bytes
+ * of a record are therefore zero.  Records are gathered into blocks of
+ * BlockRecs records, and the runs of zero bytes in a block are replaced by a
+ * count before it is written.
+ *
+ * The file is the 8 byte magic followed by blocks, each a u32 unpacked
+ * length, a u32 packed length and the packed bytes.  A packed token is a
+ * byte T < 0x80 followed by T+1 literal bytes, or a byte T >= 0x80 standing
+ * for T-0x7f zero bytes.  scripts/revtrace.py turns a file back into the
+ * text trace.
+ */
+class RevTraceFile{
+public:
+  /// RevTraceFile: record kinds and the meaning of their fields
+  enum class Kind : uint8_t {
+    Core       = 1,   ///< first record; Aux = core
+    String     = 2,   ///< Aux = string id, A = length; the bytes follow in ceil(A/32) records
+    Inst       = 3,   ///< Flag = event symbol, Reg = hart, Aux = disassembly string id,
+                      ///< A = cycle delta, B = PC delta, C = insn | tid << 32
+    RegRead    = 4,   ///< Reg = register, B = value ^ last value of the register
+    RegWrite   = 5,   ///< Reg = register, B = value ^ last value of the register
+    MemLoad    = 6,   ///< Aux = length, A = address delta, C = data (first 8 bytes)
+    MemStore   = 7,   ///< Aux = length, A = address delta, C = data (first 8 bytes)
+    MemhLoad   = 8,   ///< Aux = length, A = address delta, Reg = destination register
+    PcWrite    = 9,   ///< Aux = symbol string id (0 if none), A = delta from the instruction PC
+    Completion = 10,  ///< Flag = float destination, Reg = destination register, Aux = length,
+                      ///< A = address delta, B = hart, C = data (first 8 bytes)
+  };
+
+  /// RevTraceFile: records per compressed block
+  static constexpr size_t BlockRecs = 2048;
+
+  /// RevTraceFile: constructor; creates Path and writes the header for Core
+  RevTraceFile(const std::string& Path, unsigned Core);
+
+  /// RevTraceFile: destructor; writes the last block
+  ~RevTraceFile();
+
+  /// RevTraceFile: disallow copying and assignment
+  RevTraceFile(const RevTraceFile&) = delete;
+  RevTraceFile& operator=(const RevTraceFile&) = delete;
+
+  /// RevTraceFile: determines whether the file was created
+  bool IsOpen() const { return Good; }
+
+  /// RevTraceFile: store a string and return its id (ids start at 1)
+  uint32_t AddString(const std::string& S);
+
+  /// RevTraceFile: record a traced instruction; its effects follow it
+  void Inst(uint64_t Cycle, unsigned Hart, unsigned Tid, uint64_t PC,
+            uint32_t Insn, char Event, uint32_t Disasm);
+
+  /// RevTraceFile: record a register read or write
+  void Reg(Kind K, uint64_t R, uint64_t V);
+
+  /// RevTraceFile: record a memory access; Data is the destination register for MemhLoad
+  void Mem(Kind K, uint64_t Addr, uint64_t Len, uint64_t Data);
+
+  /// RevTraceFile: record a program counter write; Symbol is a string id or 0
+  void PcWrite(uint64_t NewPC, uint32_t Symbol);
+
+  /// RevTraceFile: record the completion of a memh load
+  void Completion(unsigned Hart, uint16_t DestReg, uint64_t Len, uint64_t Addr,
+                  uint64_t Data, bool IsFloat);
+
+  /// RevTraceFile: compress and write the records gathered so far
+  void Flush();
+
+private:
+  /// RevTraceFile: append a record, writing the block once it is full
+  void Append(const TraceFileRec& R);
+
+  /// RevTraceFile: zigzag encoded difference from Last, which becomes V
+  static uint64_t Delta(uint64_t V, uint64_t& Last);
+
+  /// RevTraceFile: flush every open trace file (the simulation may end in exit())
+  static void FlushAll();
+
+  static constexpr char Magic[8] = {'R','E','V','T','R','C','0','1'};  ///< RevTraceFile: file header
+
+  bool Good = false;                  ///< RevTraceFile: the file is usable
+  std::ofstream Out{};                ///< RevTraceFile: trace file
+  std::vector<TraceFileRec> Block{};  ///< RevTraceFile: records of the current block
+  std::vector<char> Packed{};         ///< RevTraceFile: compressed block being written
+  uint32_t NextString = 1;            ///< RevTraceFile: id of the next string
+  uint64_t LastCycle = 0;             ///< RevTraceFile: cycle of the previous instruction
+  uint64_t LastPC = 0;                ///< RevTraceFile: PC of the previous instruction
+  uint64_t LastAddr = 0;              ///< RevTraceFile: previous memory address
+  uint64_t LastReg[256] = {};         ///< RevTraceFile: last value traced for each register
+};
+
+} // namespace SST::RevCPU
+
+#endif // _SST_REVCPU_REVTRACEFILE_H_
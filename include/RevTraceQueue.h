@@ -0,0 +1,86 @@
+//
+// _RevTraceQueue_h_
+//
+// Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _SST_REVCPU_REVTRACEQUEUE_H_
+#define _SST_REVCPU_REVTRACEQUEUE_H_
+
+// -- Standard Headers
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace SST::RevCPU{
+
+/*! \class RevTraceQueue
+ *  \brief Bounded lock-free single producer, single consumer queue
+ *
+ * Hands trace records from the simulation thread to the trace writer
+ * thread.  Slots are filled in place and never destroyed, so members such
+ * as vectors keep their capacity as the queue wraps and the steady state
+ * performs no allocation.  The producer claims a slot, fills it and
+ * publishes it; the consumer reads the front slot and pops it.
+ */
+template<typename T>
+class RevTraceQueue{
+public:
+  /// RevTraceQueue: constructor; the depth is rounded up to a power of two
+  explicit RevTraceQueue(size_t Depth){
+    size_t N = 1;
+    while( N < Depth )
+      N <<= 1;
+    Slots.resize(N);
+    Mask = N - 1;
+  }
+
+  /// RevTraceQueue: disallow copying and assignment
+  RevTraceQueue(const RevTraceQueue&) = delete;
+  RevTraceQueue& operator=(const RevTraceQueue&) = delete;
+
+  /// RevTraceQueue: producer; the next free slot, or nullptr when the queue is full
+  T* Claim(){
+    size_t Pos = Tail.load(std::memory_order_relaxed);
+    if( Pos - Head.load(std::memory_order_acquire) > Mask )
+      return nullptr;
+    return &Slots[Pos & Mask];
+  }
+
+  /// RevTraceQueue: producer; hand the claimed slot to the consumer
+  void Publish(){
+    Tail.store(Tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  /// RevTraceQueue: consumer; the oldest published slot, or nullptr when the queue is empty
+  T* Front(){
+    size_t Pos = Head.load(std::memory_order_relaxed);
+    if( Pos == Tail.load(std::memory_order_acquire) )
+      return nullptr;
+    return &Slots[Pos & Mask];
+  }
+
+  /// RevTraceQueue: consumer; return the front slot to the producer
+  void Pop(){
+    Head.store(Head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  /// RevTraceQueue: determines whether the consumer has taken every published slot
+  bool Empty() const {
+    return Head.load(std::memory_order_acquire) == Tail.load(std::memory_order_acquire);
+  }
+
+private:
+  std::vector<T> Slots{};                   ///< RevTraceQueue: ring of slots
+  size_t Mask = 0;                          ///< RevTraceQueue: slot count - 1
+  alignas(64) std::atomic<size_t> Head{0};  ///< RevTraceQueue: next slot to consume
+  alignas(64) std::atomic<size_t> Tail{0};  ///< RevTraceQueue: next slot to produce
+};
+
+} // namespace SST::RevCPU
+
+#endif // _SST_REVCPU_REVTRACEQUEUE_H_
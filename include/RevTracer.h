@@ -20,11 +20,19 @@
 #include <ostream>
 #include <string>
 #include <iostream>
+#include <atomic>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 // -- Rev Headers
 #include "RevCommon.h"
+#include "RevTraceFile.h"
+#include "RevTraceQueue.h"
 
 // Integrated Disassembler (toolchain dependent)
 #ifdef REV_USE_SPIKE
@@ -45,7 +53,7 @@
 #define TRACE_PC_WRITE(PC)   { if (Tracer) Tracer->pcWrite( (PC) ); }
 #define TRACE_MEM_WRITE(ADR, LEN, DATA)    { if (Tracer) Tracer->memWrite( (ADR), (LEN), (DATA) ); }
 #define TRACE_MEM_READ(ADR, LEN, DATA)     { if (Tracer) Tracer->memRead(  (ADR), (LEN), (DATA) ); }
-#define TRACE_MEMH_SENDREAD(ADR, LEN, REG) { if (Tracer) Tracer->memhSendRead( (ADR), (LEN), (REG) ); }
+#define TRACE_MEMH_SENDREAD(ADR, LEN, REQ) { if (Tracer) Tracer->memhSendRead( (ADR), (LEN), (REQ) ); }
 #define TRACE_MEM_READ_RESPONSE(LEN, DATA, REQ) { if (Tracer) Tracer->memReadResponse( (LEN), (DATA), (REQ) ); }
 #else
 #define TRACE_REG_READ(R,V)
@@ -53,7 +61,7 @@
 #define TRACE_PC_WRITE(PC)
 #define TRACE_MEM_WRITE(ADR, LEN, DATA)
 #define TRACE_MEM_READ(ADR, LEN, DATA)
-#define TRACE_MEMH_SENDREAD(ADR, LEN, REG)
+#define TRACE_MEMH_SENDREAD(ADR, LEN, REQ)
 #define TRACE_MEM_READ_RESPONSE(LEN, DATA, REQ)
 #endif
 
@@ -90,6 +98,21 @@ namespace SST::RevCPU{
 
   constexpr unsigned NOP_COUNT = 5; // must match TRC_CMD_IDX size
   
+  // Instruction classes selectable by the trace filter
+  enum class TRC_CLASS : unsigned {
+    ALL = 0x0,
+    MEM = 0x1,      // loads, stores and atomics
+    BRANCH = 0x2,   // branches, taken or not, and jumps
+  };
+
+  const std::map<std::string,TRC_CLASS> s2class {
+    {"mem",    TRC_CLASS::MEM},
+    {"branch", TRC_CLASS::BRANCH},
+  };
+
+  // Largest span of the trace filter address ranges, in 2 byte slots (256 MiB)
+  const uint64_t MAX_FILTER_SLOTS = uint64_t(1) << 27;
+
   enum class EVENT_SYMBOL : unsigned {
     OK = 0x0,
     STALL = 0x1,
@@ -149,19 +172,55 @@ namespace SST::RevCPU{
     unsigned hart;
     unsigned tid;
     std::string defaultMnem = "?";
-    std::string& fallbackMnemonic = defaultMnem;
+    // points into the instruction table, which outlives the tracer
+    const std::string* fallbackMnemonic = &defaultMnem;
     bool valid = false;
     void set(size_t _cycle, unsigned _id, unsigned _hart, unsigned _tid, const std::string& _fallback) {
       cycle = _cycle;
       id = _id;
       hart = _hart;
       tid = _tid;
-      fallbackMnemonic = _fallback;
+      fallbackMnemonic = &_fallback;
       valid = true;
     };
     void clear() { valid = false; }
   };
 
+  // flight recorder copy of one traced instruction
+  struct FlightRec_t {
+    size_t cycle;
+    unsigned id;
+    unsigned tid;
+    uint64_t pc;
+    uint32_t insn;
+    const std::string* mnemonic;
+    std::vector<TraceRec_t> recs;   // capacity is reused as the ring wraps
+  };
+
+  // per hart ring of the most recent instructions
+  struct FlightRing_t {
+    std::vector<FlightRec_t> recs;  // slots are kept across dumps
+    size_t head = 0;                // oldest entry once the ring is full
+    size_t count = 0;               // entries recorded since the last dump
+  };
+
+  // raw trace record handed to the asynchronous writer
+  struct TraceItem_t {
+    bool completion = false;        // memh load completion rather than an instruction
+    size_t cycle = 0;
+    unsigned id = 0;
+    unsigned hart = 0;
+    unsigned tid = 0;
+    uint64_t pc = 0;                // load address for a completion
+    uint32_t insn = 0;
+    char event = 0;
+    const std::string* mnemonic = nullptr;
+    std::vector<TraceRec_t> recs;   // swapped with the capture buffer, never reallocated
+    uint16_t destReg = 0;
+    size_t len = 0;
+    uint64_t data = 0;
+  };
+
   // aggregate read completion (memh)
   struct CompletionRec_t {
     unsigned int hart;
@@ -208,7 +267,7 @@ namespace SST::RevCPU{
       /// RevTracer: capture memory read
       void memRead(uint64_t adr, size_t len, void *data);
       /// RevTracer: memh read request
-      void memhSendRead(uint64_t addr, size_t len, uint16_t reg);
+      void memhSendRead(uint64_t addr, size_t len, const MemReq& req);
       /// RevTracer: data returning from memory read (memh)
       void memReadResponse(size_t len, void *data, const MemReq* req);
       /// RevTracer: capture 32-bit program counter
@@ -221,6 +280,36 @@ namespace SST::RevCPU{
       void Render(size_t cycle);
       /// RevTracer: control whether to render captured states
       void SetOutputEnable(bool e) { outputEnabled=e; }
+      /// RevTracer: write binary records to path instead of text. Returns 0 if successful
+      int SetBinaryFile(const std::string& path, unsigned core);
+      /// RevTracer: write out buffered binary records
+      void Flush() { if (binFile) binFile->Flush(); }
+      /// RevTracer: keep the last n instructions of each hart whether or not they are rendered
+      void SetFlightRecorder(size_t n) { ringSize = n; }
+      /// RevTracer: dump the flight recorder when the instruction at pc is traced
+      void AddDumpPC(uint64_t pc) { dumpPCs.insert(pc); }
+      /// RevTracer: print and clear the flight recorder of every hart
+      void DumpFlightRecorder(const std::string& reason);
+      /// RevTracer: format and print the text trace on a writer thread fed through a
+      /// queue of depth records; when it is full records are dropped or the simulation waits
+      void SetAsyncWriter(size_t depth, bool drop);
+      /// RevTracer: wait until the writer thread has printed every queued record
+      void Drain();
+      /// RevTracer: only trace instructions in the given [lo,hi) address ranges, harts and
+      /// threads (empty: no restriction). Returns 0 if successful
+      int SetTraceFilter(const std::vector<std::pair<uint64_t,uint64_t>>& ranges,
+                         const std::vector<unsigned>& harts, const std::vector<unsigned>& tids);
+      /// RevTracer: only trace instructions of the named class (mem, branch). Returns 0 if successful
+      int AddTraceClass(const std::string& cls);
+      /// RevTracer: determines whether the instruction at pc on hart and thread is traced
+      bool InFilter(uint64_t pc, unsigned hart, unsigned tid) const {
+        if (!pcBits.empty()) {
+          uint64_t slot = (pc - pcBase) >> 1;
+          if (slot >= pcSlots || !((pcBits[slot >> 6] >> (slot & 63)) & 1))
+            return false;
+        }
+        return HartInFilter(hart) && (filterTids.empty() || filterTids.count(tid));
+      }
       /// Reset trace state
       void Reset();
 
@@ -269,6 +358,83 @@ namespace SST::RevCPU{
       std::string fmt_data(unsigned len, uint64_t data);
       /// RevTracer: Generate string from captured state
       std::string RenderExec(const std::string& fallbackMnemonic);
+      /// RevTracer: Format an instruction and its effects; updates lastpc for branches
+      std::string FormatExec(uint64_t pc, uint32_t insn, char event, const std::vector<TraceRec_t>& recs,
+                             const std::string& fallbackMnemonic, uint64_t& lastpc);
+      /// RevTracer: Format the effects of a memh load completion
+      std::string FormatCompletion(uint16_t destReg, size_t len, uint64_t addr, uint64_t data);
+      /// RevTracer: Hand captured state to the writer thread
+      void QueueExec();
+      /// RevTracer: symbol of a trace control event for the captured instruction (0 if none)
+      char EventSymbol();
+      /// RevTracer: copy the captured instruction into the flight recorder of its hart
+      void RecordFlight();
+      /// RevTracer: render text lines (verbosity >= 5)
+      bool renderText = false;
+      /// RevTracer: instructions kept per hart by the flight recorder (0 disables)
+      size_t ringSize = 0;
+      /// RevTracer: flight recorder of each hart
+      std::vector<FlightRing_t> rings;
+      /// RevTracer: instruction addresses that dump the flight recorder
+      std::unordered_set<uint64_t> dumpPCs;
+      /// RevTracer: one bit per 2 byte instruction slot from pcBase; traced PCs (empty: all)
+      std::vector<uint64_t> pcBits;
+      /// RevTracer: address of the first slot of pcBits
+      uint64_t pcBase = 0;
+      /// RevTracer: number of slots covered by pcBits
+      uint64_t pcSlots = 0;
+      /// RevTracer: traced harts (empty: all)
+      std::vector<bool> filterHarts;
+      /// RevTracer: traced threads (empty: all)
+      std::unordered_set<unsigned> filterTids;
+      /// RevTracer: mask of traced TRC_CLASS bits (0: all)
+      unsigned filterClass = 0;
+      /// RevTracer: determines whether hart is traced
+      bool HartInFilter(unsigned hart) const {
+        return filterHarts.empty() || (hart < filterHarts.size() && filterHarts[hart]);
+      }
+      /// RevTracer: TRC_CLASS bits of the captured instruction
+      unsigned InstClass() const;
+      /// RevTracer: RV32 decoding of compressed instructions (C.JAL)
+      bool rv32 = false;
+      /// RevTracer: LSQ hashes of memh loads issued by traced instructions; only their
+      /// completions are traced
+      std::unordered_multiset<uint64_t> pendingLoads;
+      /// RevTracer: queue of records for the writer thread (text is rendered inline when null)
+      std::unique_ptr<RevTraceQueue<TraceItem_t>> asyncQ;
+      /// RevTracer: writer thread
+      std::thread writer;
+      /// RevTracer: stream of the writer thread, to the destination of pOutput
+      std::unique_ptr<SST::Output> writerOutput;
+      /// RevTracer: serializes the formatters (symbols, disassembler) between the
+      /// writer thread and the simulation thread
+      std::mutex formatMutex;
+      /// RevTracer: tells the writer thread to exit once the queue is empty
+      std::atomic<bool> writerStop{false};
+      /// RevTracer: drop records rather than wait when the queue is full
+      bool dropWhenFull = false;
+      /// RevTracer: records dropped because the queue was full
+      uint64_t dropped = 0;
+      /// RevTracer: dropped records already reported
+      uint64_t droppedReported = 0;
+      /// RevTracer: claim a queue slot, applying the back-pressure policy; nullptr if dropped
+      TraceItem_t* ClaimItem();
+      /// RevTracer: writer thread body
+      void WriterLoop();
+      /// RevTracer: stop the writer thread after it has printed every queued record
+      void StopWriter();
+      /// RevTracer: finish the trace of every tracer when the simulator calls exit()
+      static void ExitAll();
+      /// RevTracer: Write captured state as binary records
+      void WriteExec(const std::string& fallbackMnemonic);
+      /// RevTracer: string id of the disassembly of the captured instruction
+      uint32_t DisasmID(const std::string& fallbackMnemonic);
+      /// RevTracer: binary trace sink (text is rendered when null)
+      std::unique_ptr<RevTraceFile> binFile;
+      /// RevTracer: string ids of the disassembly already in the binary trace
+      std::unordered_map<const void*, uint32_t> disasmIDs;
+      /// RevTracer: string ids of the symbols already in the binary trace
+      std::unordered_map<uint64_t, uint32_t> symbolIDs;
       /// RevTracer: User setting: starting cycle of trace (overrides programmtic control)
       uint64_t startCycle = 0;
       /// RevTracer: User setting: maximum number of lines to print
@@ -0,0 +1,154 @@
+//
+// _RevVFS_h_
+//
+// Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _SST_REVCPU_REVVFS_H_
+#define _SST_REVCPU_REVVFS_H_
+
+// -- Standard Headers
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+namespace SST::RevCPU{
+
+/*! \class RevVFS
+ *  \brief In-memory filesystem backing guest file I/O
+ *
+ * When enabled, every path the guest opens is resolved against an
+ * in-memory tree instead of the host filesystem.  The tree holds the host
+ * files preloaded at startup (under their absolute host paths, along with
+ * their parent directories) and anything the guest creates; writes never
+ * reach the host.  Files that were not preloaded do not exist, so a run
+ * depends only on the preloaded inputs and not on host filesystem state or
+ * latency.  The contents can be written back to a host directory when the
+ * simulation finishes.
+ *
+ * Descriptors are shared by every core and are numbered from FirstFD so
+ * they never alias the host descriptors handed to the guest (0, 1 and 2)
+ * or the descriptors of the simulator itself.  Flags and modes use the
+ * RISC-V Linux values.  All methods are called from the simulation thread.
+ */
+class RevVFS{
+public:
+  /// RevVFS: guest open(2) and *at(2) flags
+  enum : int {
+    ACCMODE   = 03,
+    RDONLY    = 00,
+    WRONLY    = 01,
+    RDWR      = 02,
+    CREAT     = 0100,
+    EXCL      = 0200,
+    TRUNC     = 01000,
+    APPEND    = 02000,
+    DIRECTORY = 0200000,
+    FDCWD     = -100,
+    REMOVEDIR = 0x200,
+  };
+
+  /// RevVFS: first descriptor number handed out
+  static constexpr int FirstFD = 1 << 24;
+
+  /// RevVFS: file status reported by Stat
+  struct Stat{
+    uint64_t Ino;     ///< Stat: inode number
+    uint32_t Mode;    ///< Stat: file type and permissions
+    int64_t  Size;    ///< Stat: size in bytes
+  };
+
+  /// RevVFS: constructor; relative paths resolve against the host directory Cwd
+  explicit RevVFS(const std::string& Cwd);
+
+  /// RevVFS: destructor
+  ~RevVFS() = default;
+
+  /// RevVFS: disallow copying and assignment
+  RevVFS(const RevVFS&) = delete;
+  RevVFS& operator=(const RevVFS&) = delete;
+
+  /// RevVFS: load the host file or directory tree at Path
+  bool Preload(const std::string& Path);
+
+  /// RevVFS: write every file and directory under the host directory Dir
+  bool Dump(const std::string& Dir) const;
+
+  /// RevVFS: determines whether fd is an open descriptor of this filesystem
+  bool IsOpen(int fd) const { return Files.count(fd) != 0; }
+
+  /// RevVFS: open Path relative to DirFd; returns a descriptor or a negative errno
+  int Open(int DirFd, const std::string& Path, int Flags, mode_t Mode);
+
+  /// RevVFS: close fd; returns 0 or a negative errno
+  int Close(int fd);
+
+  /// RevVFS: transfer Iov to (Write) or from fd at *Pos, or at the file
+  /// offset when Pos is null; returns the bytes transferred or a negative errno
+  ssize_t IO(bool Write, int fd, const std::vector<iovec>& Iov, const off_t *Pos);
+
+  /// RevVFS: reposition the offset of fd; returns the new offset or a negative errno
+  off_t Seek(int fd, off_t Offset, int Whence);
+
+  /// RevVFS: retrieve the status of fd; returns 0 or a negative errno
+  int GetStat(int fd, Stat& St) const;
+
+  /// RevVFS: append struct linux_dirent64 records for the directory fd,
+  /// filling at most Len bytes; returns the bytes added or a negative errno
+  ssize_t GetDents(int fd, size_t Len, std::vector<char>& Out);
+
+  /// RevVFS: remove Path relative to DirFd; returns 0 or a negative errno
+  int Unlink(int DirFd, const std::string& Path, int Flags);
+
+  /// RevVFS: create the directory Path relative to DirFd; returns 0 or a negative errno
+  int Mkdir(int DirFd, const std::string& Path, mode_t Mode);
+
+private:
+  /// RevVFS: file or directory
+  struct Node{
+    bool Dir;                 ///< Node: node is a directory
+    mode_t Perm;              ///< Node: permission bits
+    uint64_t Ino;             ///< Node: inode number
+    std::vector<char> Data{}; ///< Node: file contents
+  };
+
+  /// RevVFS: open file description
+  struct File{
+    std::string Path;             ///< File: absolute path at open
+    std::shared_ptr<Node> Inode;  ///< File: node, kept alive once unlinked
+    int Flags;                    ///< File: open flags
+    off_t Offset;                 ///< File: file offset (entry index for directories)
+  };
+
+  /// RevVFS: resolve Path relative to DirFd into Abs; returns 0 or a negative errno
+  int Resolve(int DirFd, const std::string& Path, std::string& Abs) const;
+
+  /// RevVFS: create a node at the absolute path Abs
+  std::shared_ptr<Node> Create(const std::string& Abs, bool Dir, mode_t Perm);
+
+  /// RevVFS: create Abs and any missing parents as directories
+  void CreateDirs(const std::string& Abs);
+
+  /// RevVFS: determines whether the parent of Abs is a directory
+  bool ParentIsDir(const std::string& Abs) const;
+
+  /// RevVFS: retrieve the absolute paths of the entries in the directory Abs
+  std::vector<std::string> Children(const std::string& Abs) const;
+
+  std::string Cwd;                                      ///< RevVFS: absolute path of the working directory
+  std::map<std::string, std::shared_ptr<Node>> Nodes{}; ///< RevVFS: absolute path to node
+  std::map<int, File> Files{};                          ///< RevVFS: open descriptors
+  uint64_t NextIno = 1;                                 ///< RevVFS: next inode number
+};
+
+} // namespace SST::RevCPU
+
+#endif // _SST_REVCPU_REVVFS_H_
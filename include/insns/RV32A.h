@@ -23,14 +23,14 @@ class RV32A : public RevExt {
   static bool lrw(RevFeature *F, RevRegFile *R, RevMem *M, const RevInst& Inst) {
     if( R->IsRV32 ){
       MemReq req(uint64_t(R->RV32[Inst.rs1]), Inst.rd, RevRegClass::RegGPR, F->GetHartToExecID(), MemOp::MemOpAMO, true, R->GetMarkLoadComplete());
-      R->LSQueue->insert( req.LSQHashPair() );
+      R->LSQInsert(req);
       M->LR(F->GetHartToExecID(), uint64_t(R->RV32[Inst.rs1]),
             &R->RV32[Inst.rd],
             Inst.aq, Inst.rl, req,
             RevFlag::F_SEXT32);
     }else{
       MemReq req(R->RV64[Inst.rs1], Inst.rd, RevRegClass::RegGPR, F->GetHartToExecID(), MemOp::MemOpAMO, true, R->GetMarkLoadComplete());
-      R->LSQueue->insert( req.LSQHashPair() );
+      R->LSQInsert(req);
       M->LR(F->GetHartToExecID(), R->RV64[Inst.rs1],
             reinterpret_cast<uint32_t*>(&R->RV64[Inst.rd]),
             Inst.aq, Inst.rl, req,
@@ -79,7 +79,7 @@ class RV32A : public RevExt {
                  MemOp::MemOpAMO,
                  true,
                  R->GetMarkLoadComplete());
-      R->LSQueue->insert( req.LSQHashPair() );
+      R->LSQInsert(req);
       M->AMOVal(F->GetHartToExecID(),
                 R->RV32[Inst.rs1],
                 &R->RV32[Inst.rs2],
@@ -95,7 +95,7 @@ class RV32A : public RevExt {
                  MemOp::MemOpAMO,
                  true,
                  R->GetMarkLoadComplete());
-      R->LSQueue->insert( req.LSQHashPair() );
+      R->LSQInsert(req);
       M->AMOVal(F->GetHartToExecID(),
                 R->RV64[Inst.rs1],
                 reinterpret_cast<int32_t*>(&R->RV64[Inst.rs2]),
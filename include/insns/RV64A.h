@@ -22,7 +22,7 @@ class RV64A : public RevExt {
 
   static bool lrd(RevFeature *F, RevRegFile *R, RevMem *M, const RevInst& Inst) {
     MemReq req(R->RV64[Inst.rs1], Inst.rd, RevRegClass::RegGPR, F->GetHartToExecID(), MemOp::MemOpAMO, true, R->GetMarkLoadComplete() );
-    R->LSQueue->insert( req.LSQHashPair() );
+    R->LSQInsert(req);
     M->LR(F->GetHartToExecID(),
           R->RV64[Inst.rs1],
           &R->RV64[Inst.rd],
@@ -63,7 +63,7 @@ class RV64A : public RevExt {
                MemOp::MemOpAMO,
                true,
                R->GetMarkLoadComplete());
-    R->LSQueue->insert( req.LSQHashPair() );
+    R->LSQInsert(req);
     M->AMOVal(F->GetHartToExecID(),
               R->RV64[Inst.rs1],
               &R->RV64[Inst.rs2],
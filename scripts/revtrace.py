@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+# All Rights Reserved
+# contact@tactcomplabs.com
+#
+# See LICENSE in the top level directory for licensing details
+#
+# revtrace.py
+#
+# Decodes a binary trace written with the RevCPU "trcFile" parameter
+# (see include/RevTraceFile.h) into the text trace format, one line per
+# traced instruction or memh load completion, without the SST logging prefix.
+#
+
+import sys
+import struct
+import argparse
+
+MAGIC = b"REVTRC01"
+REC = struct.Struct("<BBHIQQQ")
+
+CORE, STRING, INST, REGREAD, REGWRITE, MEMLOAD, MEMSTORE, MEMHLOAD, PCWRITE, COMPLETION = range(1, 11)
+
+ABI = ["zero", "ra", "sp", "gp", "tp", "t0", "t1", "t2",
+       "s0", "s1", "a0", "a1", "a2", "a3", "a4", "a5",
+       "a6", "a7", "s2", "s3", "s4", "s5", "s6", "s7",
+       "s8", "s9", "s10", "s11", "t3", "t4", "t5", "t6"]
+
+MASK64 = (1 << 64) - 1
+
+def blocks(f):
+  if f.read(len(MAGIC)) != MAGIC:
+    sys.exit("not a Rev binary trace")
+  while True:
+    hdr = f.read(8)
+    if len(hdr) < 8:
+      return
+    rawLen, packedLen = struct.unpack("<II", hdr)
+    packed = f.read(packedLen)
+    raw = bytearray()
+    i = 0
+    while i < len(packed):
+      t = packed[i]
+      if t >= 0x80:
+        raw += bytes(t - 0x7f)
+        i += 1
+      else:
+        raw += packed[i+1:i+2+t]
+        i += 2 + t
+    if len(raw) != rawLen:
+      sys.exit("corrupt block")
+    yield raw
+
+def records(f):
+  for raw in blocks(f):
+    for off in range(0, len(raw), REC.size):
+      yield REC.unpack_from(raw, off)
+
+def unzigzag(v):
+  return (v >> 1) ^ -(v & 1)
+
+class Decoder:
+  def __init__(self, abi):
+    self.abi = abi
+    self.core = 0
+    self.strings = {}
+    self.lastCycle = 0
+    self.lastPC = 0
+    self.lastAddr = 0
+    self.lastReg = [0] * 256
+    self.branchPC = 0     # RevTracer::lastPC
+    self.inst = None
+    self.effects = []
+    self.squash = False
+
+  def reg(self, r):
+    r &= 0xff
+    if self.abi:
+      return ABI[r] if r < 32 else "?%d" % r
+    return "x%d" % r
+
+  @staticmethod
+  def data(length, d):
+    if length == 0:
+      return ""
+    if length > 8:
+      return "0x%016x..+%d" % (d, (8 - length) & 0xffffffff)
+    return "0x%0*x" % (length * 2, d & ((1 << (length * 8)) - 1))
+
+  def addr(self, delta):
+    self.lastAddr = (self.lastAddr + unzigzag(delta)) & MASK64
+    return self.lastAddr
+
+  def flush(self, out):
+    if self.inst is None:
+      return
+    line = self.inst
+    if self.effects:
+      line += " " + "".join(self.effects)
+    out.write(line + "\n")
+    self.inst = None
+    self.effects = []
+
+  def decode(self, f, out):
+    pending = None   # [id, length, bytes] of a string being read
+    for kind, flag, reg, aux, a, b, c in records(f):
+      if pending:
+        pending[2] += REC.pack(kind, flag, reg, aux, a, b, c)
+        if len(pending[2]) >= pending[1]:
+          self.strings[pending[0]] = pending[2][:pending[1]].decode(errors="replace")
+          pending = None
+        continue
+
+      if kind == CORE:
+        self.core = aux
+      elif kind == STRING:
+        if a:
+          pending = [aux, a, b""]
+        else:
+          self.strings[aux] = ""
+      elif kind == INST:
+        self.flush(out)
+        self.lastCycle = (self.lastCycle + unzigzag(a)) & MASK64
+        self.lastPC = (self.lastPC + unzigzag(b)) & MASK64
+        event = chr(flag) if flag else ""
+        self.inst = "Core %d; Hart %d; Thread %d; *I 0x%x:%08x %2s %s\t" % (
+          self.core, reg, c >> 32, self.lastPC, c & 0xffffffff, event, self.strings.get(aux, "?"))
+        self.squash = False
+      elif kind in (REGREAD, REGWRITE):
+        v = b ^ self.lastReg[reg % 256]
+        self.lastReg[reg % 256] = v
+        if kind == REGREAD:
+          self.effects.append("0x%x<-%s " % (v, self.reg(reg)))
+        elif self.squash:
+          self.squash = False
+        else:
+          self.effects.append("%s<-0x%x " % (self.reg(reg), v))
+      elif kind == MEMSTORE:
+        self.effects.append("[0x%x,%d]<-%s " % (self.addr(a), aux, self.data(aux, c)))
+      elif kind == MEMLOAD:
+        self.effects.append("%s<-[0x%x,%d] " % (self.data(aux, c), self.addr(a), aux))
+      elif kind == MEMHLOAD:
+        self.effects.append("%s<-[0x%x,%d] " % (self.reg(reg), self.addr(a), aux))
+        self.squash = True
+      elif kind == PCWRITE:
+        pc = (self.lastPC + unzigzag(a)) & MASK64
+        if (self.branchPC + 4) & MASK64 != pc:
+          s = "pc<-0x%x" % pc
+          if aux:
+            s += " <%s>" % self.strings.get(aux, "?")
+          self.effects.append(s + " ")
+        self.branchPC = pc
+      elif kind == COMPLETION:
+        self.flush(out)
+        d = self.data(aux, c)
+        out.write("Hart %d; *A %s<-[0x%x,%d] %s<-%s \n" % (b, d, self.addr(a), aux, self.reg(reg), d))
+      else:
+        sys.exit("unknown record kind %d" % kind)
+    self.flush(out)
+
+def main():
+  parser = argparse.ArgumentParser(description="Decode a Rev binary instruction trace (trcFile) to text")
+  parser.add_argument('traces', nargs='+', help="trace files, e.g. trace.0 trace.1")
+  parser.add_argument('--abi', action='store_true', help="use ABI register names (as with REV_USE_SPIKE)")
+  args = parser.parse_args()
+
+  for name in args.traces:
+    try:
+      f = open(name, 'rb')
+    except OSError:
+      sys.exit("Cannot open file " + name)
+    with f:
+      Decoder(args.abi).decode(f, sys.stdout)
+
+if __name__ == "__main__":
+  main()
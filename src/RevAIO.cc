@@ -0,0 +1,241 @@
+//
+// _RevAIO_cc_
+//
+// Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#include "RevAIO.h"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <unistd.h>
+
+namespace SST::RevCPU{
+
+RevAIO::RevAIO(unsigned Threads, uint64_t Latency, uint64_t Bandwidth)
+  : Threads(std::max(Threads, 1u)), Latency(Latency), Bandwidth(Bandwidth) {
+}
+
+RevAIO::~RevAIO(){
+  {
+    std::lock_guard<std::mutex> guard(Lock);
+    Stop = true;
+  }
+  Wakeup.notify_all();
+  for( auto& W : Workers )
+    W.join();
+}
+
+uint64_t RevAIO::Setup(unsigned MaxEvents){
+  // most simulations never use AIO, so the workers start on first use
+  if( Workers.empty() ){
+    for( unsigned i = 0; i < Threads; i++ )
+      Workers.emplace_back(&RevAIO::Worker, this);
+  }
+  uint64_t Ctx = NextCtx++;
+  Contexts.emplace(Ctx, Context{MaxEvents, {}});
+  return Ctx;
+}
+
+bool RevAIO::Destroy(uint64_t Ctx){
+  auto it = Contexts.find(Ctx);
+  if( it == Contexts.end() )
+    return false;
+
+  {
+    // drop the requests no worker has picked up yet
+    std::lock_guard<std::mutex> guard(Lock);
+    Queue.erase(std::remove_if(Queue.begin(), Queue.end(),
+                               [&](const auto& R){
+                                 return std::find(it->second.Requests.begin(),
+                                                  it->second.Requests.end(),
+                                                  R) != it->second.Requests.end();
+                               }),
+                Queue.end());
+  }
+
+  // the guest buffers must not be touched once io_destroy returns
+  {
+    std::unique_lock<std::mutex> guard(Lock);
+    Finished.wait(guard, [&]{
+      return std::all_of(it->second.Requests.begin(), it->second.Requests.end(),
+                         [](const auto& R){ return !R->Started || R->Done; });
+    });
+  }
+  Contexts.erase(it);
+  return true;
+}
+
+int RevAIO::Submit(uint64_t Ctx, uint64_t Data, uint64_t Obj, Op Oper, int Fd,
+                   std::vector<iovec>&& Iov, off_t Offset, uint64_t Bytes){
+  auto it = Contexts.find(Ctx);
+  if( it == Contexts.end() )
+    return -EINVAL;
+  if( it->second.Requests.size() >= it->second.MaxEvents )
+    return -EAGAIN;
+
+  auto R = std::make_shared<Request>();
+  R->Data   = Data;
+  R->Obj    = Obj;
+  R->Oper   = Oper;
+  R->Fd     = Fd;
+  R->Iov    = std::move(Iov);
+  R->Offset = Offset;
+
+  // requests occupy the modeled device one after another
+  uint64_t Transfer = Bandwidth ? (Bytes + Bandwidth - 1) / Bandwidth : 0;
+  DeviceFree = std::max(DeviceFree, Now) + Transfer;
+  R->DueCycle = DeviceFree + Latency;
+  NextDue = std::min(NextDue, R->DueCycle);
+
+  it->second.Requests.push_back(R);
+  {
+    std::lock_guard<std::mutex> guard(Lock);
+    Queue.push_back(std::move(R));
+  }
+  Wakeup.notify_one();
+  return 0;
+}
+
+size_t RevAIO::Ready(uint64_t Ctx) const {
+  auto it = Contexts.find(Ctx);
+  if( it == Contexts.end() )
+    return 0;
+  // a request may fall due in the cycle it was submitted, after Advance
+  // ran, so its host I/O is only waited for when it is reaped
+  return std::count_if(it->second.Requests.begin(), it->second.Requests.end(),
+                       [this](const auto& R){ return R->DueCycle <= Now; });
+}
+
+size_t RevAIO::Reap(uint64_t Ctx, size_t Max, std::vector<Event>& Out){
+  auto it = Contexts.find(Ctx);
+  if( it == Contexts.end() )
+    return 0;
+
+  size_t N = 0;
+  auto& Reqs = it->second.Requests;
+  for( auto R = Reqs.begin(); R != Reqs.end() && N < Max; ){
+    if( (*R)->DueCycle <= Now ){
+      Finish(*R);
+      Out.push_back({(*R)->Data, (*R)->Obj, (*R)->Res, 0});
+      R = Reqs.erase(R);
+      N++;
+    }else{
+      ++R;
+    }
+  }
+  return N;
+}
+
+bool RevAIO::Cancel(uint64_t Ctx, uint64_t Obj, Event& Out){
+  auto it = Contexts.find(Ctx);
+  if( it == Contexts.end() )
+    return false;
+
+  auto& Reqs = it->second.Requests;
+  auto R = std::find_if(Reqs.begin(), Reqs.end(), [&](const auto& Q){ return Q->Obj == Obj; });
+  if( R == Reqs.end() )
+    return false;
+
+  {
+    std::lock_guard<std::mutex> guard(Lock);
+    if( (*R)->Started )
+      return false;
+    Queue.erase(std::find(Queue.begin(), Queue.end(), *R));
+  }
+  Out = {(*R)->Data, (*R)->Obj, -ECANCELED, 0};
+  Reqs.erase(R);
+  return true;
+}
+
+void RevAIO::Worker(){
+  for(;;){
+    std::shared_ptr<Request> R;
+    {
+      std::unique_lock<std::mutex> guard(Lock);
+      Wakeup.wait(guard, [this]{ return Stop || !Queue.empty(); });
+      // requests still queued at shutdown are abandoned
+      if( Stop )
+        return;
+      R = std::move(Queue.front());
+      Queue.pop_front();
+      R->Started = true;
+    }
+    R->Res = Execute(*R);
+    {
+      std::lock_guard<std::mutex> guard(Lock);
+      R->Done = true;
+    }
+    Finished.notify_all();
+  }
+}
+
+void RevAIO::Finish(const std::shared_ptr<Request>& R){
+  std::unique_lock<std::mutex> guard(Lock);
+  if( !R->Started ){
+    Queue.erase(std::find(Queue.begin(), Queue.end(), R));
+    R->Started = true;
+    guard.unlock();
+    R->Res = Execute(*R);
+    guard.lock();
+    R->Done = true;
+    return;
+  }
+  Finished.wait(guard, [&]{ return R->Done; });
+}
+
+void RevAIO::FinishDue(){
+  NextDue = UINT64_MAX;
+  for( auto& [Ctx, C] : Contexts ){
+    for( auto& R : C.Requests ){
+      if( R->DueCycle > Now ){
+        NextDue = std::min(NextDue, R->DueCycle);
+      }else{
+        Finish(R);
+      }
+    }
+  }
+}
+
+int64_t RevAIO::Execute(Request& R){
+  switch( R.Oper ){
+  case Op::Fsync:
+    return fsync(R.Fd) < 0 ? -errno : 0;
+  case Op::Fdsync:
+#ifdef __APPLE__
+    return fsync(R.Fd) < 0 ? -errno : 0;
+#else
+    return fdatasync(R.Fd) < 0 ? -errno : 0;
+#endif
+  case Op::Noop:
+    return 0;
+  case Op::Read:
+  case Op::Write:
+    break;
+  }
+
+  int64_t Total = 0;
+  for( size_t i = 0; i < R.Iov.size(); ){
+    int Cnt = int(std::min<size_t>(R.Iov.size() - i, IOV_MAX));
+    ssize_t Want = 0;
+    for( int j = 0; j < Cnt; j++ )
+      Want += R.Iov[i+j].iov_len;
+
+    ssize_t rc = R.Oper == Op::Write ?
+      pwritev(R.Fd, &R.Iov[i], Cnt, R.Offset + Total) :
+      preadv(R.Fd, &R.Iov[i], Cnt, R.Offset + Total);
+    if( rc < 0 )
+      return Total ? Total : -errno;
+    Total += rc;
+    if( rc < Want )
+      break;
+    i += Cnt;
+  }
+  return Total;
+}
+
+} // namespace SST::RevCPU
@@ -11,6 +11,8 @@
 #include "RevCPU.h"
 #include "RevMem.h"
 #include "RevThread.h"
+#include <algorithm>
+#include <cerrno>
 #include <cmath>
 #include <memory>
 
@@ -62,12 +64,70 @@ RevCPU::RevCPU( SST::ComponentId_t id, const SST::Params& params )
                  "Building Rev with %" PRIu32 " cores and %" PRIu32 " hart(s) on each core \n",
                  numCores, numHarts);
 
+  // Setup the per-core ready queues and the thread placement policy
+  ReadyQueues.resize(numCores);
+  const std::string schedPolicy = params.find<std::string>("schedPolicy", "roundrobin");
+  if( schedPolicy == "roundrobin" ){
+    Policy = SchedPolicy::RoundRobin;
+  }else if( schedPolicy == "fill" ){
+    Policy = SchedPolicy::FillFirst;
+  }else if( schedPolicy == "spread" ){
+    Policy = SchedPolicy::Spread;
+  }else{
+    output.fatal(CALL_INFO, -1, "Error: unknown schedPolicy %s; expected roundrobin, fill or spread\n",
+                 schedPolicy.c_str());
+  }
+
+  // Read the default affinity of each thread: "N:mask" applies to the Nth
+  // thread created (0 is the main thread) and "THREADS:mask" to the rest
+  std::vector<std::string> threadAffinity;
+  params.find_array<std::string>("threadAffinity", threadAffinity);
+  for( const auto& Entry : threadAffinity ){
+    auto Colon = Entry.find(':');
+    uint64_t Mask = 0;
+    try{
+      if( Colon != std::string::npos )
+        Mask = std::stoull(Entry.substr(Colon + 1), nullptr, 0);
+    }catch( const std::exception& ){
+      Mask = 0;
+    }
+    if( numCores * numHarts < 64 )
+      Mask &= ~(~uint64_t{0} << (numCores * numHarts));
+    if( !Mask ){
+      output.fatal(CALL_INFO, -1, "Error: threadAffinity entry %s does not select any of the %" PRIu32 " CPUs\n",
+                   Entry.c_str(), numCores * numHarts);
+    }
+    std::string Key = Entry.substr(0, Colon);
+    if( Key == "THREADS" ){
+      DefaultAffinity = Mask;
+    }else{
+      try{
+        ThreadAffinity[std::stoull(Key)] = Mask;
+      }catch( const std::exception& ){
+        output.fatal(CALL_INFO, -1, "Error: threadAffinity entry %s has an invalid thread index\n", Entry.c_str());
+      }
+    }
+  }
+
   // read the binary executable name
   Exe = params.find<std::string>("program", "a.out");
 
   // read the program arguments
   Args = params.find<std::string>("args", "");
 
+  // Open the record/replay log before anything draws on the host
+  const std::string recordLog = params.find<std::string>("recordLog", "");
+  const std::string replayLog = params.find<std::string>("replayLog", "");
+  if( !recordLog.empty() && !replayLog.empty() )
+    output.fatal(CALL_INFO, -1, "Error: recordLog and replayLog are mutually exclusive\n");
+  if( !recordLog.empty() || !replayLog.empty() ){
+    bool Replaying = !replayLog.empty();
+    Replay = std::make_unique<RevReplay>(Replaying ? replayLog : recordLog, Replaying);
+    if( !Replay->IsOpen() )
+      output.fatal(CALL_INFO, -1, "Error: failed to open the %s log %s\n",
+                   Replaying ? "replay" : "record", Replaying ? replayLog.c_str() : recordLog.c_str());
+  }
+
   // Create the options object
   // TODO: Use std::nothrow to return null instead of throwing std::bad_alloc
   Opts = new RevOpts(numCores, numHarts, Verbosity);
@@ -105,6 +165,21 @@ RevCPU::RevCPU( SST::ComponentId_t id, const SST::Params& params )
     params.find_array<std::string>("prefetchDepth", prefetchDepths);
     if( !Opts->InitPrefetchDepth( prefetchDepths) )
       output.fatal(CALL_INFO, -1, "Error: failed to initalize the prefetch depth\n" );
+
+    std::vector<std::string> lsqDepths;
+    params.find_array<std::string>("lsqDepth", lsqDepths);
+    if( !Opts->InitLSQDepth( lsqDepths ) )
+      output.fatal(CALL_INFO, -1, "Error: failed to initialize the load/store queue depth\n" );
+
+    std::vector<std::string> syscallBWs;
+    params.find_array<std::string>("syscallBandwidth", syscallBWs);
+    if( !Opts->InitSyscallBandwidth( syscallBWs ) )
+      output.fatal(CALL_INFO, -1, "Error: failed to initialize the syscall bandwidth\n" );
+
+    std::vector<std::string> syscallTables;
+    params.find_array<std::string>("syscallTable", syscallTables);
+    if( !Opts->InitSyscallTables( syscallTables ) )
+      output.fatal(CALL_INFO, -1, "Error: failed to initialize the syscall cost tables\n" );
   }
 
   // See if we should load the network interface controller
@@ -161,6 +236,9 @@ RevCPU::RevCPU( SST::ComponentId_t id, const SST::Params& params )
       output.verbose(CALL_INFO, 1, 0, "Warning: memory faults cannot be enabled with memHierarchy support\n");
   }
 
+  // The memory controller tells harts apart across cores
+  Mem->SetHartsPerCore(numHarts);
+
   // Set TLB Size
   const uint64_t tlbSize = params.find<unsigned long>("tlbSize", 512);
   Mem->SetTLBSize(tlbSize);
@@ -169,7 +247,8 @@ RevCPU::RevCPU( SST::ComponentId_t id, const SST::Params& params )
   const uint64_t maxHeapSize = params.find<unsigned long>("maxHeapSize", memSize/4);
   Mem->SetMaxHeapSize(maxHeapSize);
 
-  // Load the binary into memory
+  // Load the binary into memory; the loader writes as hart 0 of core 0
+  Mem->SetActiveCore(0);
   // TODO: Use std::nothrow to return null instead of throwing std::bad_alloc
   Loader = new RevLoader( Exe, Args, Mem, &output );
   if( !Loader ){
@@ -184,7 +263,8 @@ RevCPU::RevCPU( SST::ComponentId_t id, const SST::Params& params )
     // Create the processor objects
     Procs.reserve(Procs.size() + numCores);
     for( unsigned i=0; i<numCores; i++ ){
-      Procs.push_back( new RevProc( i, Opts, numHarts, Mem, Loader, this->GetNewTID(), &output ) );
+      Procs.push_back( new RevProc( i, Opts, numHarts, Mem, Loader, this->GetNewTID(),
+                                    this->GetFutexWake(), &output ) );
     }
     // Create the co-processor objects
     for( unsigned i=0; i<numCores; i++){
@@ -199,16 +279,76 @@ RevCPU::RevCPU( SST::ComponentId_t id, const SST::Params& params )
     // Create the processor objects
     Procs.reserve(Procs.size() + numCores);
     for( unsigned i=0; i<numCores; i++ ){
-      Procs.push_back( new RevProc( i, Opts, numHarts, Mem, Loader, this->GetNewTID(), &output ) );
+      Procs.push_back( new RevProc( i, Opts, numHarts, Mem, Loader, this->GetNewTID(),
+                                    this->GetFutexWake(), &output ) );
     }
   }
 
   #ifndef NO_REV_TRACER
   // Configure tracer and assign to each core
-  if (output.getVerboseLevel()>=5) {
+  // A binary trace file replaces the text trace, and neither it nor the
+  // flight recorder needs any verbosity
+  std::string trcFile = params.find<std::string>("trcFile", "");
+  size_t trcRing = params.find<size_t>("trcRing", 0);
+  bool trcAsync = params.find<bool>("trcAsync", false);
+  size_t trcQueue = params.find<size_t>("trcQueue", 65536);
+  std::string trcFull = params.find<std::string>("trcFull", "block");
+  if( trcFull != "block" && trcFull != "drop" )
+    output.fatal(CALL_INFO, -1, "Error: trcFull must be block or drop, not %s\n", trcFull.c_str());
+  if( trcAsync && !trcQueue )
+    output.fatal(CALL_INFO, -1, "Error: trcQueue must be greater than 0\n");
+  std::vector<uint64_t> trcDumpPCs;
+  {
+    std::vector<std::string> trcDumpAt;
+    params.find_array<std::string>("trcDumpAt", trcDumpAt);
+    for( const auto& At : trcDumpAt ){
+      uint64_t PC = At.rfind("0x", 0) == 0 ? std::stoull(At, nullptr, 16) : Loader->GetSymbolAddr(At);
+      if( !PC )
+        output.fatal(CALL_INFO, -1, "Error: trcDumpAt names an unknown symbol: %s\n", At.c_str());
+      trcDumpPCs.push_back(PC);
+    }
+  }
+  // trace filters: address ranges from functions and explicit ranges, harts, threads and classes
+  std::vector<std::pair<uint64_t,uint64_t>> trcRanges;
+  {
+    std::vector<std::string> trcSymbols;
+    params.find_array<std::string>("trcSymbols", trcSymbols);
+    auto* Symbols = Loader->GetTraceSymbols();
+    for( const auto& Sym : trcSymbols ){
+      // a function extends up to the next symbol
+      uint64_t Lo = Loader->GetSymbolAddr(Sym);
+      auto Next = Symbols->upper_bound(Lo);
+      if( !Lo || Next == Symbols->end() )
+        output.fatal(CALL_INFO, -1, "Error: trcSymbols names an unknown or unbounded symbol: %s\n", Sym.c_str());
+      trcRanges.emplace_back(Lo, Next->first);
+    }
+
+    std::vector<std::string> trcRange;
+    params.find_array<std::string>("trcRange", trcRange);
+    for( const auto& R : trcRange ){
+      size_t Dash = R.find('-');
+      uint64_t Lo = 0, Hi = 0;
+      try{
+        Lo = std::stoull(R.substr(0, Dash), nullptr, 0);
+        Hi = std::stoull(R.substr(Dash + 1), nullptr, 0);
+      }catch(...){
+        Dash = std::string::npos;
+      }
+      if( Dash == std::string::npos || Lo >= Hi )
+        output.fatal(CALL_INFO, -1, "Error: trcRange must be lo-hi with lo < hi: %s\n", R.c_str());
+      trcRanges.emplace_back(Lo, Hi);
+    }
+  }
+  std::vector<unsigned> trcHarts, trcThreads;
+  params.find_array<unsigned>("trcHarts", trcHarts);
+  params.find_array<unsigned>("trcThreads", trcThreads);
+  std::vector<std::string> trcClass;
+  params.find_array<std::string>("trcClass", trcClass);
+
+  if (output.getVerboseLevel()>=5 || !trcFile.empty() || trcRing) {
     for( unsigned i=0; i<numCores; i++ ){
       // Each core gets its very own tracer
-      RevTracer* trc = new RevTracer(getName(), &output);
+      RevTracer* trc = Tracers.emplace_back(std::make_unique<RevTracer>(getName(), &output)).get();
       std::string diasmType;
       Opts->GetMachineModel(0,diasmType); // TODO first param is core
       if (trc->SetDisassembler(diasmType))
@@ -221,6 +361,26 @@ RevCPU::RevCPU( SST::ComponentId_t id, const SST::Params& params )
       trc->SetCycleLimit(params.find<uint64_t>("trcLimit",0));
       trc->SetCmdTemplate(params.find<std::string>("trcOp", TRC_OP_DEFAULT).c_str());
 
+      // flight recorder, dumped at these PCs, by rev_trace_dump, on a fatal error and at finish
+      trc->SetFlightRecorder(trcRing);
+      for( uint64_t PC : trcDumpPCs )
+        trc->AddDumpPC(PC);
+
+      // core N writes <trcFile>.N
+      if (!trcFile.empty() && trc->SetBinaryFile(trcFile + "." + std::to_string(i), i))
+        output.fatal(CALL_INFO, -1, "Error: could not create trace file %s.%" PRIu32 "\n", trcFile.c_str(), i);
+
+      // only instructions passing every filter are traced
+      if (trc->SetTraceFilter(trcRanges, trcHarts, trcThreads))
+        output.fatal(CALL_INFO, -1, "Error: trace filter address ranges are empty or span more than 256 MiB\n");
+      for( const auto& Cls : trcClass )
+        if (trc->AddTraceClass(Cls))
+          output.fatal(CALL_INFO, -1, "Error: unknown trcClass %s (mem, branch)\n", Cls.c_str());
+
+      // text trace formatted and printed by a writer thread
+      if (trcAsync && trcFile.empty() && output.getVerboseLevel()>=5)
+        trc->SetAsyncWriter(trcQueue, trcFull == "drop");
+
       // clear trace states
       trc->Reset();
 
@@ -236,6 +396,37 @@ RevCPU::RevCPU( SST::ComponentId_t id, const SST::Params& params )
     Procs[i]->SetTimeConverter(timeConverter);
   }
 
+  // Setup the asynchronous I/O engine shared by all cores
+  AIO = std::make_unique<RevAIO>(params.find<unsigned>("aioThreads", 4),
+                                 params.find<uint64_t>("aioLatency", 1000),
+                                 params.find<uint64_t>("aioBandwidth", 8));
+  for( size_t i=0; i<Procs.size(); i++){
+    Procs[i]->SetAIO(AIO.get());
+    Procs[i]->SetReplay(Replay.get());
+  }
+
+  // Setup preemptive time slicing
+  const uint64_t timeSlice = params.find<uint64_t>("timeSlice", 0);
+  const uint64_t contextSwitchCost = params.find<uint64_t>("contextSwitchCost", 100);
+  for( size_t i=0; i<Procs.size(); i++){
+    Procs[i]->SetTimeSlice(timeSlice, contextSwitchCost);
+  }
+
+  // Setup the in-memory filesystem shared by all cores
+  if( params.find<bool>("enableVFS", 0) ){
+    VFS = std::make_unique<RevVFS>(std::filesystem::current_path().string());
+    std::vector<std::string> vfsPreload;
+    params.find_array<std::string>("vfsPreload", vfsPreload);
+    for( const auto& Path : vfsPreload ){
+      if( !VFS->Preload(Path) )
+        output.fatal(CALL_INFO, -1, "Error: failed to preload %s into the in-memory filesystem\n", Path.c_str());
+    }
+    VFSDumpDir = params.find<std::string>("vfsDumpDir", "");
+    for( size_t i=0; i<Procs.size(); i++){
+      Procs[i]->SetVFS(VFS.get());
+    }
+  }
+
   // Initial thread setup
   uint32_t MainThreadID = id+1; // Prevents having MainThreadID == 0 which is reserved for INVALID
 
@@ -293,6 +484,18 @@ RevCPU::RevCPU( SST::ComponentId_t id, const SST::Params& params )
   FloatsExec.reserve(numCores);
   TLBHitsPerCore.reserve(numCores);
   TLBMissesPerCore.reserve(numCores);
+  LSQForwards.reserve(numCores);
+  LSQViolations.reserve(numCores);
+  LSQFullStalls.reserve(numCores);
+  CyclesStalledLSQ.reserve(numCores);
+  SyscallsExec.reserve(numCores);
+  SyscallCycles.reserve(numCores);
+  SyscallBytes.reserve(numCores);
+  SyscallProfile.resize(numCores);
+  Preemptions.reserve(numCores);
+  ContextSwitchCycles.reserve(numCores);
+  ThreadMigrations.reserve(numCores);
+  ReadyQueueDepth.reserve(numCores);
 
   for(unsigned s = 0; s < numCores; s++){
     auto core = "core_" + std::to_string(s);
@@ -307,8 +510,29 @@ RevCPU::RevCPU( SST::ComponentId_t id, const SST::Params& params )
     FloatsExec.push_back( registerStatistic<uint64_t>("FloatsExec", core));
     TLBHitsPerCore.push_back( registerStatistic<uint64_t>("TLBHitsPerCore", core));
     TLBMissesPerCore.push_back( registerStatistic<uint64_t>("TLBMissesPerCore", core));
+    LSQForwards.push_back( registerStatistic<uint64_t>("LSQForwards", core));
+    LSQViolations.push_back( registerStatistic<uint64_t>("LSQViolations", core));
+    LSQFullStalls.push_back( registerStatistic<uint64_t>("LSQFullStalls", core));
+    CyclesStalledLSQ.push_back( registerStatistic<uint64_t>("CyclesStalledLSQ", core));
+    SyscallsExec.push_back( registerStatistic<uint64_t>("SyscallsExec", core));
+    SyscallCycles.push_back( registerStatistic<uint64_t>("SyscallCycles", core));
+    SyscallBytes.push_back( registerStatistic<uint64_t>("SyscallBytes", core));
+    for( uint32_t Code : RevProc::GetEcallCodes() ){
+      auto sub = core + "." + std::to_string(Code);
+      SyscallProfile[s][Code] = { registerStatistic<uint64_t>("SyscallCalls", sub),
+                                  registerStatistic<uint64_t>("SyscallCallCycles", sub),
+                                  registerStatistic<uint64_t>("SyscallCallBytes", sub) };
+    }
+    Preemptions.push_back( registerStatistic<uint64_t>("Preemptions", core));
+    ContextSwitchCycles.push_back( registerStatistic<uint64_t>("ContextSwitchCycles", core));
+    ThreadMigrations.push_back( registerStatistic<uint64_t>("ThreadMigrations", core));
+    ReadyQueueDepth.push_back( registerStatistic<uint64_t>("ReadyQueueDepth", core));
   }
 
+  FutexWaits = registerStatistic<uint64_t>("FutexWaits");
+  FutexWakes = registerStatistic<uint64_t>("FutexWakes");
+  FutexBlockedCycles = registerStatistic<uint64_t>("FutexBlockedCycles");
+
   // determine whether we need to enable/disable manual coproc clocking
   DisableCoprocClock = params.find<bool>("independentCoprocClock", 0);
 
@@ -325,6 +549,9 @@ RevCPU::RevCPU( SST::ComponentId_t id, const SST::Params& params )
 }
 
 RevCPU::~RevCPU(){
+  // stop the AIO workers before the guest memory they target goes away
+  AIO.reset();
+
   // delete the competion array
   delete[] Enabled;
 
@@ -452,6 +679,20 @@ void RevCPU::setup(){
 }
 
 void RevCPU::finish(){
+  for( auto& trc : Tracers ){
+    trc->DumpFlightRecorder("finish");
+    trc->Flush();
+  }
+  if( VFS && !VFSDumpDir.empty() && !VFS->Dump(VFSDumpDir) )
+    output.fatal(CALL_INFO, -1, "Error: failed to write the in-memory filesystem to %s\n", VFSDumpDir.c_str());
+}
+
+// Called by SST when the simulation aborts, e.g. on a fatal error
+void RevCPU::emergencyShutdown(){
+  for( auto& trc : Tracers ){
+    trc->DumpFlightRecorder("emergency shutdown");
+    trc->Flush();
+  }
 }
 
 void RevCPU::init( unsigned int phase ){
@@ -579,18 +820,46 @@ void RevCPU::UpdateCoreStatistics(unsigned coreNum){
   FloatsExec[coreNum]->addData(stats.floatsExec);
   TLBHitsPerCore[coreNum]->addData(memStats.TLBHits);
   TLBMissesPerCore[coreNum]->addData(memStats.TLBMisses);
+  LSQForwards[coreNum]->addData(stats.lsqForwards);
+  LSQViolations[coreNum]->addData(stats.lsqViolations);
+  LSQFullStalls[coreNum]->addData(stats.lsqFullStalls);
+  CyclesStalledLSQ[coreNum]->addData(stats.cyclesStalled_LSQ);
+  SyscallsExec[coreNum]->addData(stats.syscallsExec);
+  SyscallCycles[coreNum]->addData(stats.cyclesSyscall);
+  SyscallBytes[coreNum]->addData(stats.syscallBytes);
+  for( const auto& [Code, Prof] : Procs[coreNum]->GetAndClearEcallProfile() ){
+    const auto& Stat = SyscallProfile[coreNum].at(Code);
+    Stat.Calls->addData(Prof.Calls);
+    Stat.Cycles->addData(Prof.Cycles);
+    Stat.Bytes->addData(Prof.Bytes);
+  }
+  Preemptions[coreNum]->addData(stats.preemptions);
+  ContextSwitchCycles[coreNum]->addData(stats.cyclesContextSwitch);
 }
 
 bool RevCPU::clockTick( SST::Cycle_t currentCycle ){
   bool rtn = true;
 
   output.verbose(CALL_INFO, 8, 0, "Cycle: %" PRIu64 "\n", currentCycle);
+  CurrentCycle = currentCycle;
+  AIO->Advance(currentCycle);
+
+  // Wake any threads whose sleep or futex timeout has expired
+  SleepTimers.Advance(currentCycle, [this](uint32_t ThreadID, uint64_t When){
+    ExpireSleepTimer(ThreadID, When);
+  });
 
   // Execute each enabled core
   for( size_t i=0; i<Procs.size(); i++ ){
+    // Memory accesses made for this core, by it or by the scheduler, come
+    // from its harts; RevProc::ClockTick sets this as well
+    Mem->SetActiveCore(unsigned(i));
+
     // Check if we have more work to assign and places to put it
     UpdateThreadAssignments(i);
     if( Enabled[i] ){
+      // Threads still queued here compete for the harts of this core
+      Procs[i]->SetThreadsWaiting(!ReadyQueues[i].empty());
       if( !Procs[i]->ClockTick(currentCycle) ){
         if(EnableCoProc && !CoProcs.empty()){
           CoProcs[i]->Teardown();
@@ -639,19 +908,39 @@ bool RevCPU::clockTick( SST::Cycle_t currentCycle ){
 
   // If all Procs are disabled (ie. rtn == false at this point)
   // check to see if there are threads to assign
-  if( ReadyThreads.size() ){
+  if( HasReadyThreads() ){
     rtn = false;
-  } else if ( BlockedThreads.size() ){
-    CheckBlockedThreads();
+  }
+
+  // Sleeping threads will be woken by their timers
+  if( rtn && !SleepTimers.Empty() ){
     rtn = false;
   }
 
+  // Nothing is running and nothing can run: a wake-up will never come
+  if( rtn && (!FutexQueues.empty() || !JoinWaiters.empty()) ){
+    output.fatal(CALL_INFO, -1,
+                 "Error: deadlock at cycle %" PRIu64 "; every remaining thread is blocked in FUTEX_WAIT or pthread_join\n",
+                 static_cast<uint64_t>(currentCycle));
+  }
+
+  // Whatever is left is in pause() or an untimed ppoll.  Only a signal could
+  // wake them and none will be delivered, so the run ends here like a
+  // program that is killed while it waits.
+  bool OnlyPaused = false;
+  if( rtn && !SleepingThreads.empty() ){
+    output.verbose(CALL_INFO, 2, 0,
+                   "%zu thread(s) paused with nothing left to wake them; ending at cycle %" PRIu64 "\n",
+                   SleepingThreads.size(), static_cast<uint64_t>(currentCycle));
+    OnlyPaused = true;
+  }
+
   // check to see if the network has any outstanding messages: fixme
   if( !TrackTags.empty() || !ZeroRqst.empty() ){
     rtn = false;
   }
 
-  if( rtn && CompletedThreads.size() ){
+  if( rtn && (ThreadsCompleted || OnlyPaused) ){
     for( unsigned i=0; i<numCores; i++ ){
       UpdateCoreStatistics(i);
       Procs[i]->PrintStatSummary();
@@ -668,7 +957,7 @@ bool RevCPU::clockTick( SST::Cycle_t currentCycle ){
 
 // Initializes a RevThread object.
 // - Moves it to the 'Threads' map
-// - Adds it's ThreadID to the ReadyThreads to be scheduled
+// - Adds it to a ready queue to be scheduled
 void RevCPU::InitThread(std::unique_ptr<RevThread>&& ThreadToInit){
   // Get a pointer to the register state for this thread
   std::unique_ptr<RevRegFile> RegState = ThreadToInit->TransferVirtRegState();
@@ -680,7 +969,7 @@ void RevCPU::InitThread(std::unique_ptr<RevThread>&& ThreadToInit){
   ThreadToInit->SetState(ThreadState::READY);
   output.verbose(CALL_INFO, 4, 0, "Initializing Thread %" PRIu32 "\n", ThreadToInit->GetID());
   output.verbose(CALL_INFO, 11, 0, "Thread Information: %s", ThreadToInit->to_string().c_str());
-  ReadyThreads.emplace_back(std::move(ThreadToInit));
+  ScheduleThread(std::move(ThreadToInit));
 }
 
 // Assigns a RevThred to a specific Proc which then loads it into a RevHart
@@ -691,45 +980,230 @@ void RevCPU::AssignThread(std::unique_ptr<RevThread>&& ThreadToAssign, unsigned
   return;
 }
 
-// Checks if a thread with a given Thread ID can proceed (used for pthread_join).
-// it does this by seeing if a given thread's WaitingOnTID has completed
-bool RevCPU::ThreadCanProceed(const std::unique_ptr<RevThread>& Thread){
-  bool rtn = false;
-
-  // Get the thread's waiting to join TID
+// Parks a thread blocked in pthread_join on the wait list of the thread it
+// joins, or readies it right away when that thread has already completed.
+// Waiters are only touched again when the joined thread reaches DONE, so a
+// blocked thread costs nothing per cycle.
+void RevCPU::JoinThread(std::unique_ptr<RevThread>&& Thread){
   uint32_t WaitingOnTID = Thread->GetWaitingToJoinTID();
-
-  // If the thread is waiting on another thread, check if that thread has completed
+  if( WaitingOnTID != _INVALID_TID_ && !CompletedThreads.count(WaitingOnTID) ){
+    output.verbose(CALL_INFO, 6, 0, "Thread %" PRIu32 " is waiting on Thread %" PRIu32 "\n", Thread->GetID(), WaitingOnTID);
+    JoinWaiters[WaitingOnTID].emplace_back(std::move(Thread));
+    return;
+  }
   if( WaitingOnTID != _INVALID_TID_ ){
-    // Check if WaitingOnTID has completed... if so, return = true, else return false
-    output.verbose(CALL_INFO, 6, 0, "Thread %" PRIu32 " is waiting on Thread %u\n", Thread->GetID(), WaitingOnTID);
+    ReclaimThread(WaitingOnTID);
+  }
+  Thread->SetWaitingToJoinTID(_INVALID_TID_);
+  WakeThread(std::move(Thread));
+}
 
-    // Check if the WaitingOnTID has completed, if not, thread cannot proceed
-    rtn = ( CompletedThreads.find(WaitingOnTID) != CompletedThreads.end() ) ? true : false;
+// Readies every thread waiting to join the thread ThreadID, which has just completed
+void RevCPU::WakeJoinWaiters(uint32_t ThreadID){
+  auto it = JoinWaiters.find(ThreadID);
+  if( it == JoinWaiters.end() ){
+    return;
+  }
+  for( auto& Waiter : it->second ){
+    output.verbose(CALL_INFO, 6, 0, "Thread %" PRIu32 " joined Thread %" PRIu32 "\n", Waiter->GetID(), ThreadID);
+    Waiter->SetWaitingToJoinTID(_INVALID_TID_);
+    ReclaimThread(ThreadID);
+    WakeThread(std::move(Waiter));
   }
-  // If the thread is not waiting on another thread, it can proceed
-  else {
-    // Thread is waiting on INVALID_TID (ie. No thread)
-    // so it can proceed
-    rtn = true;
+  JoinWaiters.erase(it);
+}
+
+// Frees a completed thread once it has been joined (or as soon as it
+// completes when it is detached), since it can never be joined again: its
+// stack/TLS segment and register file go back to their pools for new
+// threads, and the files it still has open are closed with it
+void RevCPU::ReclaimThread(uint32_t ThreadID){
+  auto it = CompletedThreads.find(ThreadID);
+  if( it == CompletedThreads.end() ){
+    return;
   }
+  auto& Thread = it->second;
 
-  return rtn;
+  // clone()d threads run on a guest allocated stack
+  if( Thread->GetThreadMem() ){
+    Mem->ReleaseThreadMem(Thread->GetThreadMem());
+  }
+  if( Thread->GetLastCore() < numCores ){
+    Procs[Thread->GetLastCore()]->RecycleRegFile(Thread->TransferVirtRegState());
+  }
+  CompletedThreads.erase(it);
+  output.verbose(CALL_INFO, 8, 0, "Thread %" PRIu32 " reclaimed\n", ThreadID);
 }
 
-// Checks if any of the blocked threads can proceed based on if the thread
-// they were waiting on has completed
-void RevCPU::CheckBlockedThreads(){
-  // Iterate over all block threads
-  for( auto it = BlockedThreads.begin(); it != BlockedThreads.end(); ) {
-    if( ThreadCanProceed(*it) ){
-      ReadyThreads.emplace_back(std::move(*it));
-      it = BlockedThreads.erase(it);
-    }else{
-      ++it;
+// Wakes up to NWake threads waiting on the futex at Addr whose bitset
+// intersects Bitset, then moves up to NRequeue of the remaining waiters
+// (regardless of bitset) onto the futex at Addr2
+uint64_t RevCPU::FutexWake(uint64_t Addr, uint64_t NWake, uint32_t Bitset,
+                           uint64_t Addr2, uint64_t NRequeue){
+  auto it = FutexQueues.find(Addr);
+  if( it == FutexQueues.end() ){
+    return 0;
+  }
+
+  uint64_t Woken = 0;
+  auto& Waiters = it->second;
+  for( auto w = Waiters.begin(); w != Waiters.end() && Woken < NWake; ){
+    if( !((*w)->GetFutexBitset() & Bitset) ){
+      ++w;
+      continue;
+    }
+    output.verbose(CALL_INFO, 6, 0, "Thread %" PRIu32 " woken from futex 0x%" PRIx64 "\n",
+                   (*w)->GetID(), Addr);
+    TimedFutexWaiters.erase((*w)->GetID());
+    FutexWakes->addData(1);
+    FutexBlockedCycles->addData(CurrentCycle - (*w)->GetBlockedCycle());
+    WakeThread(std::move(*w));
+    w = Waiters.erase(w);
+    Woken++;
+  }
+
+  uint64_t Requeued = 0;
+  if( NRequeue && Addr2 != Addr ){
+    auto& Target = FutexQueues[Addr2];
+    while( !Waiters.empty() && Requeued < NRequeue ){
+      Waiters.front()->SetFutexWait(Addr2, Waiters.front()->GetFutexBitset());
+      if( auto t = TimedFutexWaiters.find(Waiters.front()->GetID()); t != TimedFutexWaiters.end() ){
+        t->second = Addr2;
+      }
+      Target.splice(Target.end(), Waiters, Waiters.begin());
+      Requeued++;
+    }
+    if( Target.empty() ){
+      FutexQueues.erase(Addr2);
+    }
+    // FutexQueues[Addr2] may have rehashed the table
+    it = FutexQueues.find(Addr);
+  }
+
+  if( it->second.empty() ){
+    FutexQueues.erase(it);
+  }
+  return Woken + Requeued;
+}
+
+// Moves a thread that was blocked or sleeping to a ready queue
+void RevCPU::WakeThread(std::unique_ptr<RevThread>&& Thread){
+  Thread->SetFutexWait(0, 0);
+  Thread->ClearSleep();
+  Thread->SetState(ThreadState::READY);
+  ScheduleThread(std::move(Thread));
+}
+
+// Queues a ready thread.  A thread that ran before goes back to its last
+// core, whose caches and TLB are most likely to still hold its state; the
+// placement policy only decides where new threads start.
+void RevCPU::ScheduleThread(std::unique_ptr<RevThread>&& Thread){
+  unsigned ProcID = Thread->GetLastCore();
+  if( ProcID >= numCores || !Procs[ProcID]->AllowsThread(*Thread) ){
+    ProcID = PlaceThread(*Thread);
+  }
+  ReadyQueues[ProcID].emplace_back(std::move(Thread));
+  ReadyQueueDepth[ProcID]->addData(ReadyQueues[ProcID].size());
+}
+
+// Chooses a core for a new thread (or one whose affinity excludes its last
+// core) among the cores its affinity allows:
+// - roundrobin: cycle through the cores
+// - fill: the lowest core with a free hart, packing threads onto as few
+//   cores as possible
+// - spread: the core with the fewest running and queued threads
+unsigned RevCPU::PlaceThread(const RevThread& Thread){
+  unsigned Best = _REV_INVALID_CORE_ID_;
+  switch( Policy ){
+  case SchedPolicy::RoundRobin:
+    for( unsigned n=0; n<numCores; n++ ){
+      unsigned i = (NextCore + n) % numCores;
+      if( Procs[i]->AllowsThread(Thread) ){
+        NextCore = (i + 1) % numCores;
+        return i;
+      }
+    }
+    break;
+  case SchedPolicy::FillFirst:
+    for( unsigned i=0; i<numCores; i++ ){
+      if( Procs[i]->AllowsThread(Thread) && GetCoreLoad(i) < numHarts ){
+        return i;
+      }
+    }
+    [[fallthrough]];
+  case SchedPolicy::Spread:
+    for( unsigned i=0; i<numCores; i++ ){
+      if( Procs[i]->AllowsThread(Thread) &&
+          (Best == _REV_INVALID_CORE_ID_ || GetCoreLoad(i) < GetCoreLoad(Best)) ){
+        Best = i;
+      }
+    }
+    break;
+  }
+  if( Best == _REV_INVALID_CORE_ID_ ){
+    output.fatal(CALL_INFO, -1, "Error: the affinity of Thread %" PRIu32 " allows none of the cores\n",
+                 Thread.GetID());
+  }
+  return Best;
+}
+
+// Sets the affinity the configuration gives to the next thread created,
+// counting the main thread as thread 0
+void RevCPU::ApplyThreadAffinity(RevThread& Thread){
+  uint64_t Index = ThreadsCreated++;
+  if( auto it = ThreadAffinity.find(Index); it != ThreadAffinity.end() ){
+    Thread.SetAffinity({it->second});
+  }else if( DefaultAffinity ){
+    Thread.SetAffinity({DefaultAffinity});
+  }
+}
+
+bool RevCPU::HasReadyThreads() const {
+  for( const auto& Queue : ReadyQueues ){
+    if( !Queue.empty() ){
+      return true;
+    }
+  }
+  return false;
+}
+
+// Wakes the thread whose sleep (or futex timeout) expired at cycle When.
+// Timers are never cancelled, so a timer that no longer matches the
+// thread's wake cycle is stale and ignored.
+void RevCPU::ExpireSleepTimer(uint32_t ThreadID, uint64_t When){
+  if( auto it = SleepingThreads.find(ThreadID); it != SleepingThreads.end() ){
+    if( it->second->GetWakeCycle() == When ){
+      output.verbose(CALL_INFO, 6, 0, "Thread %" PRIu32 " woke from sleep\n", ThreadID);
+      WakeThread(std::move(it->second));
+      SleepingThreads.erase(it);
+    }
+    return;
+  }
+
+  auto t = TimedFutexWaiters.find(ThreadID);
+  if( t == TimedFutexWaiters.end() ){
+    return;
+  }
+  auto q = FutexQueues.find(t->second);
+  if( q == FutexQueues.end() ){
+    return;
+  }
+  auto& Waiters = q->second;
+  for( auto w = Waiters.begin(); w != Waiters.end(); ++w ){
+    if( (*w)->GetID() == ThreadID && (*w)->GetWakeCycle() == When ){
+      output.verbose(CALL_INFO, 6, 0, "Thread %" PRIu32 " timed out on futex 0x%" PRIx64 "\n",
+                     ThreadID, t->second);
+      (*w)->GetVirtRegState()->SetX(RevReg::a0, -ETIMEDOUT);
+      FutexBlockedCycles->addData(CurrentCycle - (*w)->GetBlockedCycle());
+      WakeThread(std::move(*w));
+      Waiters.erase(w);
+      if( Waiters.empty() ){
+        FutexQueues.erase(q);
+      }
+      TimedFutexWaiters.erase(t);
+      return;
     }
   }
-  return;
 }
 
 // ----------------------------------
@@ -748,26 +1222,59 @@ void RevCPU::SetupArgs(const std::unique_ptr<RevRegFile>& RegFile){
 }
 
 // Checks core 'i' to see if it has any available harts to assign work to
-// if it does and there is work to assign (ie. ReadyThreads is not empty)
-// assign it and enable the processor if not already enabled.
+// if it does and there is work to assign (ie. its ready queue holds a thread
+// whose affinity allows one of the idle harts) assign it and enable the
+// processor if not already enabled.  A core with an idle hart and nothing
+// it can run queued steals from a core whose harts are all busy.
 void RevCPU::UpdateThreadAssignments(uint32_t ProcID){
-  // Check if we have anything to assign
-  if( ReadyThreads.empty() ){
+  // Check if this proc has room
+  if( !Procs[ProcID]->HasIdleHart() ){
     return;
   }
 
-  // There is work to assign, check if this proc has room
-  if( Procs[ProcID]->HasIdleHart() ){
-    // There is room, assign a thread
-    // Get the next thread to assign
-    Procs[ProcID]->AssignThread(std::move(ReadyThreads.front()));
-
-    // Remove thread from ready threads vector
-    ReadyThreads.erase(ReadyThreads.begin());
+  auto Fits = [this, ProcID](const std::unique_ptr<RevThread>& T){
+    return Procs[ProcID]->HasIdleHartFor(*T);
+  };
 
-    // Proc has a thread assigned to it, enable it
-     Enabled[ProcID] = true;
+  std::unique_ptr<RevThread> Thread;
+  auto& Queue = ReadyQueues[ProcID];
+  if( auto it = std::find_if(Queue.begin(), Queue.end(), Fits); it != Queue.end() ){
+    Thread = std::move(*it);
+    Queue.erase(it);
+  }else{
+    // Nothing to run here: steal from the busy core with the most waiting.
+    // The victim runs its queue from the front, so take the last thread
+    // that fits, which would otherwise wait longest
+    size_t Most = 0;
+    std::deque<std::unique_ptr<RevThread>>* Victim = nullptr;
+    std::deque<std::unique_ptr<RevThread>>::reverse_iterator Steal;
+    for( unsigned i=0; i<numCores; i++ ){
+      auto& Other = ReadyQueues[i];
+      if( i == ProcID || Other.size() <= Most || Procs[i]->HasIdleHart() ){
+        continue;
+      }
+      if( auto it = std::find_if(Other.rbegin(), Other.rend(), Fits); it != Other.rend() ){
+        Most = Other.size();
+        Victim = &Other;
+        Steal = it;
+      }
+    }
+    if( !Victim ){
+      return;
+    }
+    Thread = std::move(*Steal);
+    Victim->erase(std::prev(Steal.base()));
+    output.verbose(CALL_INFO, 6, 0, "Core %" PRIu32 " stole Thread %" PRIu32 "\n",
+                   ProcID, Thread->GetID());
+    ThreadMigrations[ProcID]->addData(1);
   }
+
+  // There is room, assign the thread
+  Thread->SetLastCore(ProcID);
+  Procs[ProcID]->AssignThread(std::move(Thread));
+
+  // Proc has a thread assigned to it, enable it
+  Enabled[ProcID] = true;
   return;
 }
 
@@ -784,27 +1291,65 @@ void RevCPU::HandleThreadStateChangesForProc(uint32_t ProcID){
       // This thread has completed execution
       output.verbose(CALL_INFO, 8, 0, "Thread %" PRIu32 " on Core %" PRIu32 " is DONE\n", ThreadID, ProcID);
       CompletedThreads.emplace(ThreadID, std::move(Thread));
+      ThreadsCompleted++;
+      WakeJoinWaiters(ThreadID);
+      // Nobody joins a detached thread through the simulator (clone()d
+      // threads are joined by the guest via the child tid futex)
+      if( auto done = CompletedThreads.find(ThreadID);
+          done != CompletedThreads.end() && done->second->IsDetached() ){
+        ReclaimThread(ThreadID);
+      }
       break;
 
     case ThreadState::BLOCKED:
-      // This thread is blocked (currently only caused by a rev_pthread_join)
+      // This thread is blocked (caused by a rev_pthread_join or a FUTEX_WAIT)
       output.verbose(CALL_INFO, 8, 0, "Thread %" PRIu32 "on Core %" PRIu32 " is BLOCKED\n", ThreadID, ProcID);
 
       // Set its state to BLOCKED
       Thread->SetState(ThreadState::BLOCKED);
+      Thread->SetBlockedCycle(CurrentCycle);
+
+      if( Thread->IsSleeping() && Thread->GetSleepCycles() != UINT64_MAX ){
+        // Arm its wake-up timer (a futex wait with a timeout is both
+        // queued on the futex and timed)
+        uint64_t Cycles = std::min(Thread->GetSleepCycles(), UINT64_MAX - 1 - CurrentCycle);
+        Thread->SetWakeCycle(CurrentCycle + Cycles);
+        if( Thread->GetSleepCycles() ){
+          SleepTimers.Schedule(Thread->GetWakeCycle(), ThreadID);
+        }
+      }
 
-      // Add it to BlockedThreads
-      BlockedThreads.emplace_back(std::move(Thread));
+      if( uint64_t Addr = Thread->GetFutexAddr() ){
+        // Park it on its futex until another thread wakes it
+        FutexWaits->addData(1);
+        if( Thread->IsSleeping() ){
+          TimedFutexWaiters[ThreadID] = Addr;
+        }
+        FutexQueues[Addr].emplace_back(std::move(Thread));
+      }else if( Thread->IsSleeping() && Thread->GetSleepCycles() == 0 ){
+        // sched_yield: go to the back of the ready queue so that any other
+        // ready thread gets the hart first
+        WakeThread(std::move(Thread));
+      }else if( Thread->IsSleeping() ){
+        // nanosleep/pause: wait for the timer (or forever)
+        SleepingThreads.emplace(ThreadID, std::move(Thread));
+      }else{
+        // pthread_join: wait for the joined thread to complete
+        JoinThread(std::move(Thread));
+      }
       break;
     case ThreadState::START:
       // A new thread was created
       output.verbose(CALL_INFO, 99, 1, "A new thread with ID = %" PRIu32 " was found on Core %" PRIu32, Thread->GetID(), ProcID);
 
+      // Apply the configured placement, which overrides the inherited affinity
+      ApplyThreadAffinity(*Thread);
+
       // Mark it ready for execution
       Thread->SetState(ThreadState::READY);
 
-      // Add it to the ReadyThreads so it is scheduled
-      ReadyThreads.emplace_back(std::move(Thread));
+      // Queue it on a core so it is scheduled
+      ScheduleThread(std::move(Thread));
 
       break;
 
@@ -813,9 +1358,10 @@ void RevCPU::HandleThreadStateChangesForProc(uint32_t ProcID){
       break;
 
     case ThreadState::READY:
-      // If this happens we are not setting state when assigning thread somewhere
-      output.fatal(CALL_INFO, 99, "Error: Thread %" PRIu32 " on Core %" PRIu32 " is assigned but is in READY state... This is a bug\n",
-                    ThreadID, ProcID);
+      // This thread was preempted at the end of its time slice, so it goes
+      // behind the threads already waiting for this core
+      output.verbose(CALL_INFO, 8, 0, "Thread %" PRIu32 " on Core %" PRIu32 " was preempted\n", ThreadID, ProcID);
+      ScheduleThread(std::move(Thread));
       break;
     default: // Should DEFINITELY never happen
       output.fatal(CALL_INFO, 99, "Error: Thread %" PRIu32 " on Core %" PRIu32 " is in an unknown state... This is a bug.\n%s\n",
@@ -829,6 +1375,20 @@ void RevCPU::HandleThreadStateChangesForProc(uint32_t ProcID){
   }
 }
 
+uint32_t RevCPU::GetNewThreadID(){
+  int64_t ID;
+  if( Replay && Replay->IsReplaying() ){
+    if( !Replay->Get(RevReplay::Event::Random, 0, ID) )
+      output.fatal(CALL_INFO, -1, "Error: replay diverged from the log at event %" PRIu64 " (thread ID)\n",
+                   Replay->GetCount());
+    return uint32_t(ID);
+  }
+  ID = RevRand(0, UINT32_MAX);
+  if( Replay )
+    Replay->Put(RevReplay::Event::Random, 0, ID);
+  return uint32_t(ID);
+}
+
 void RevCPU::InitMainThread(uint32_t MainThreadID, const uint64_t StartAddr){
   // @Lee: Is there a better way to get the feature info?
   std::unique_ptr<RevRegFile> MainThreadRegState = std::make_unique<RevRegFile>(Procs[0]->GetRevFeature());
@@ -843,11 +1403,15 @@ void RevCPU::InitMainThread(uint32_t MainThreadID, const uint64_t StartAddr){
                                                                       Mem->GetThreadMemSegs().front(),
                                                                       std::move(MainThreadRegState));
   MainThread->SetState(ThreadState::READY);
+  if( Replay && Replay->IsReplaying() )
+    MainThread->SetCloseFDs(false);
+  ApplyThreadAffinity(*MainThread);
 
   output.verbose(CALL_INFO, 11, 0, "Main thread initialized %s\n", MainThread->to_string().c_str());
 
-  // Add to ReadyThreads so it gets scheduled
-  ReadyThreads.emplace_back(std::move(MainThread));
+  // Queue it so it gets scheduled (statistics are not registered yet)
+  unsigned ProcID = PlaceThread(*MainThread);
+  ReadyQueues[ProcID].emplace_back(std::move(MainThread));
 }
 
 } // namespace SST::RevCPU
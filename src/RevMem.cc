@@ -10,6 +10,7 @@
 
 #include "RevMem.h"
 #include "RevRand.h"
+#include <algorithm>
 #include <cstring>
 #include <cmath>
 #include <utility>
@@ -143,7 +144,7 @@ bool RevMem::LRBase(unsigned Hart, uint64_t Addr, size_t Len,
   char *DataMem = (char *)(Target);
 
   if( ctrl ){
-    ctrl->sendREADLOCKRequest(Hart, Addr, (uint64_t)(BaseMem),
+    ctrl->sendREADLOCKRequest(CtrlHart(Hart), Addr, (uint64_t)(BaseMem),
                               Len, Target, req, flags);
   }else{
     memcpy(DataMem, BaseMem, Len);
@@ -394,7 +395,18 @@ uint64_t RevMem::AddRoundedMemSeg(uint64_t BaseAddr, const uint64_t& SegSize, si
   return BaseAddr;
 }
 
-std::shared_ptr<MemSegment> RevMem::AddThreadMem(){
+std::shared_ptr<MemSegment> RevMem::AddThreadMem(unsigned Hart){
+  // Reuse the memory of a reclaimed thread if there is one.  Its TLS area
+  // (which holds the TID) is cleared so the new thread starts from zeroed
+  // TLS like a fresh segment, not from the values the last owner left
+  if( !FreeThreadMemSegs.empty() ){
+    ThreadMemSegs.emplace_back(std::move(FreeThreadMemSegs.back()));
+    FreeThreadMemSegs.pop_back();
+    const std::vector<char> Zeros(TLSSize);
+    WriteMem(Hart, ThreadMemSegs.back()->getTopAddr() - TLSSize, TLSSize, Zeros.data());
+    return ThreadMemSegs.back();
+  }
+
   // Calculate the BaseAddr of the segment
   uint64_t BaseAddr = NextThreadMemAddr - ThreadMemSize;
   ThreadMemSegs.emplace_back(std::make_shared<MemSegment>(BaseAddr, ThreadMemSize));
@@ -403,6 +415,18 @@ std::shared_ptr<MemSegment> RevMem::AddThreadMem(){
   return ThreadMemSegs.back();
 }
 
+// Released segments leave ThreadMemSegs, which keeps the address checks
+// proportional to the number of live threads
+void RevMem::ReleaseThreadMem(const std::shared_ptr<MemSegment>& Seg){
+  auto it = std::find(ThreadMemSegs.begin(), ThreadMemSegs.end(), Seg);
+  if( it == ThreadMemSegs.end() ){
+    output->fatal(CALL_INFO, -1, "Error: released thread memory at 0x%" PRIx64 " is not allocated\n",
+                  Seg->getBaseAddr());
+  }
+  FreeThreadMemSegs.emplace_back(std::move(*it));
+  ThreadMemSegs.erase(it);
+}
+
 void RevMem::SetTLSInfo(const uint64_t& BaseAddr, const uint64_t& Size){
   TLSBaseAddr = BaseAddr;
   TLSSize += Size;
@@ -536,7 +560,7 @@ uint64_t RevMem::AllocMemAt(const uint64_t& BaseAddr, const uint64_t& SegSize){
 
 bool RevMem::FenceMem(unsigned Hart){
   if( ctrl ){
-    return ctrl->sendFENCE(Hart);
+    return ctrl->sendFENCE(CtrlHart(Hart));
   }
   return true;  // base RevMem support does nothing here
 }
@@ -555,7 +579,7 @@ bool RevMem::AMOMem(unsigned Hart, uint64_t Addr, size_t Len,
 
   if( ctrl ){
     // sending to the RevMemCtrl
-    ctrl->sendAMORequest(Hart, Addr, (uint64_t)(BaseMem), Len,
+    ctrl->sendAMORequest(CtrlHart(Hart), Addr, (uint64_t)(BaseMem), Len,
                          static_cast<char *>(Data), Target, req, flags);
   }else{
     // process the request locally
@@ -618,7 +642,7 @@ bool RevMem::WriteMem( unsigned Hart, uint64_t Addr, size_t Len, const void *Dat
     std::cout << "Warning: Writing off end of page... " << std::endl;
 #endif
     if( ctrl ){
-      ctrl->sendWRITERequest(Hart, Addr,
+      ctrl->sendWRITERequest(CtrlHart(Hart), Addr,
                              (uint64_t)(BaseMem),
                              Len,
                              DataMem,
@@ -632,7 +656,7 @@ bool RevMem::WriteMem( unsigned Hart, uint64_t Addr, size_t Len, const void *Dat
     if( ctrl ){
       // write the memory using RevMemCtrl
       unsigned Cur = (Len-span);
-      ctrl->sendWRITERequest(Hart, Addr,
+      ctrl->sendWRITERequest(CtrlHart(Hart), Addr,
                              (uint64_t)(BaseMem),
                              Len,
                              &(DataMem[Cur]),
@@ -648,7 +672,7 @@ bool RevMem::WriteMem( unsigned Hart, uint64_t Addr, size_t Len, const void *Dat
   }else{
     if( ctrl ){
       // write the memory using RevMemCtrl
-      ctrl->sendWRITERequest(Hart, Addr,
+      ctrl->sendWRITERequest(CtrlHart(Hart), Addr,
                              (uint64_t)(BaseMem),
                              Len,
                              DataMem,
@@ -707,7 +731,7 @@ bool RevMem::WriteMem( unsigned Hart, uint64_t Addr, size_t Len, const void *Dat
     std::cout << "Warning: Writing off end of page... " << std::endl;
 #endif
     if( ctrl ){
-      ctrl->sendWRITERequest(Hart, Addr,
+      ctrl->sendWRITERequest(CtrlHart(Hart), Addr,
                              (uint64_t)(BaseMem),
                              Len,
                              DataMem,
@@ -721,7 +745,7 @@ bool RevMem::WriteMem( unsigned Hart, uint64_t Addr, size_t Len, const void *Dat
     if( ctrl ){
       // write the memory using RevMemCtrl
       unsigned Cur = (Len-span);
-      ctrl->sendWRITERequest(Hart, Addr,
+      ctrl->sendWRITERequest(CtrlHart(Hart), Addr,
                              (uint64_t)(BaseMem),
                              Len,
                              &(DataMem[Cur]),
@@ -743,7 +767,7 @@ bool RevMem::WriteMem( unsigned Hart, uint64_t Addr, size_t Len, const void *Dat
   }else{
     if( ctrl ){
       // write the memory using RevMemCtrl
-      ctrl->sendWRITERequest(Hart, Addr,
+      ctrl->sendWRITERequest(CtrlHart(Hart), Addr,
                              (uint64_t)(BaseMem),
                              Len,
                              DataMem,
@@ -816,7 +840,7 @@ bool RevMem::ReadMem(unsigned Hart, uint64_t Addr, size_t Len, void *Target,
     adjPageNum = ((Addr+Len)-span) >> addrShift;
     adjPhysAddr = CalcPhysAddr(adjPageNum, ((Addr+Len)-span));
     if( ctrl ){
-      ctrl->sendREADRequest(Hart, Addr, (uint64_t)(BaseMem), Len, Target, req, flags);
+      ctrl->sendREADRequest(CtrlHart(Hart), Addr, (uint64_t)(BaseMem), Len, Target, req, flags);
     }else{
       for( unsigned i=0; i< (Len-span); i++ ){
         DataMem[i] = BaseMem[i];
@@ -839,8 +863,8 @@ bool RevMem::ReadMem(unsigned Hart, uint64_t Addr, size_t Len, void *Target,
 #endif
   }else{
     if( ctrl ){
-      TRACE_MEMH_SENDREAD(req.Addr, Len, req.DestReg);
-      ctrl->sendREADRequest(Hart, Addr, (uint64_t)(BaseMem), Len, Target, req, flags);
+      TRACE_MEMH_SENDREAD(req.Addr, Len, req);
+      ctrl->sendREADRequest(CtrlHart(Hart), Addr, (uint64_t)(BaseMem), Len, Target, req, flags);
     }else{
       for( unsigned i=0; i<Len; i++ ){
         DataMem[i] = BaseMem[i];
@@ -857,11 +881,22 @@ bool RevMem::ReadMem(unsigned Hart, uint64_t Addr, size_t Len, void *Target,
   return true;
 }
 
+char *RevMem::GetHostPtr( uint64_t Addr, size_t &Len ){
+  Len = 0;
+  if( !physMem )
+    return nullptr;
+
+  uint64_t pageNum = Addr >> addrShift;
+  uint64_t physAddr = CalcPhysAddr(pageNum, Addr);
+  Len = pageSize - (Addr & (pageSize - 1));
+  return &physMem[physAddr];
+}
+
 bool RevMem::FlushLine( unsigned Hart, uint64_t Addr ){
   uint64_t pageNum = Addr >> addrShift;
   uint64_t physAddr = CalcPhysAddr(pageNum, Addr);
   if( ctrl ){
-    ctrl->sendFLUSHRequest(Hart, Addr, physAddr, getLineSize(),
+    ctrl->sendFLUSHRequest(CtrlHart(Hart), Addr, physAddr, getLineSize(),
                            false, RevFlag::F_NONE);
   }
   // else, this is effectively a nop
@@ -872,7 +907,7 @@ bool RevMem::InvLine( unsigned Hart, uint64_t Addr ){
   uint64_t pageNum = Addr >> addrShift;
   uint64_t physAddr = CalcPhysAddr(pageNum, Addr);
   if( ctrl ){
-    ctrl->sendFLUSHRequest(Hart, Addr, physAddr, getLineSize(),
+    ctrl->sendFLUSHRequest(CtrlHart(Hart), Addr, physAddr, getLineSize(),
                            true, RevFlag::F_NONE);
   }
   // else, this is effectively a nop
@@ -883,8 +918,8 @@ bool RevMem::CleanLine( unsigned Hart, uint64_t Addr ){
   uint64_t pageNum = Addr >> addrShift;
   uint64_t physAddr = CalcPhysAddr(pageNum, Addr);
   if( ctrl ){
-    ctrl->sendFENCE(Hart);
-    ctrl->sendFLUSHRequest(Hart, Addr, physAddr, getLineSize(),
+    ctrl->sendFENCE(CtrlHart(Hart));
+    ctrl->sendFLUSHRequest(CtrlHart(Hart), Addr, physAddr, getLineSize(),
                            false, RevFlag::F_NONE);
   }
   // else, this is effectively a nop
@@ -126,6 +126,8 @@ RevBasicMemCtrl::RevBasicMemCtrl(ComponentId_t id, const Params& params)
     hasCache(false), lineSize(0),
     max_loads(64), max_stores(64), max_flush(64), max_llsc(64),
     max_readlock(64), max_writeunlock(64), max_custom(64), max_ops(2),
+    max_mshr(16), max_mshr_targets(8), max_wc_stores(16), wc_timeout(32),
+    currentCycle(0),
     num_read(0x00ull), num_write(0x00ull), num_flush(0x00ull), num_llsc(0x00ull),
     num_readlock(0x00ull), num_writeunlock(0x00ull), num_custom(0x00ull),
     num_fence(0x00ull) {
@@ -142,6 +144,15 @@ RevBasicMemCtrl::RevBasicMemCtrl(ComponentId_t id, const Params& params)
   max_writeunlock = params.find<unsigned>("max_writeunlock", 64);
   max_custom = params.find<unsigned>("max_custom", 64);
   max_ops = params.find<unsigned>("ops_per_cycle", 2);
+  max_mshr = params.find<unsigned>("max_mshr", 16);
+  max_mshr_targets = params.find<unsigned>("max_mshr_targets", 8);
+
+  if( max_mshr > 0 && max_mshr_targets == 0 ){
+    output->fatal(CALL_INFO, -1, "Error : max_mshr_targets must be > 0 when max_mshr is enabled\n");
+  }
+
+  max_wc_stores = params.find<unsigned>("max_wc_stores", 16);
+  wc_timeout = params.find<uint64_t>("wc_timeout", 32);
 
   rqstQ.reserve(max_ops);
 
@@ -209,6 +220,12 @@ void RevBasicMemCtrl::registerStats(){
       "AMOMaxuPending",
       "AMOSwapBytes",
       "AMOSwapPending",
+      "MSHRAlloc",
+      "MSHRMerge",
+      "MSHRFull",
+      "WCStores",
+      "WCFlushes",
+      "WCWrites",
     }){
     stats.push_back(registerStatistic<uint64_t>(stat));
   }
@@ -216,7 +233,7 @@ void RevBasicMemCtrl::registerStats(){
 
 void RevBasicMemCtrl::recordStat(RevBasicMemCtrl::MemCtrlStats Stat,
                                  uint64_t Data){
-  if( Stat > RevBasicMemCtrl::MemCtrlStats::AMOSwapPending){
+  if( Stat > RevBasicMemCtrl::MemCtrlStats::WCWrites){
     // do nothing
     return;
   }
@@ -231,6 +248,7 @@ bool RevBasicMemCtrl::sendFLUSHRequest(unsigned Hart,
                                        RevFlag flags){
   if( Size == 0 )
     return true;
+  flushWCLine(Addr, Size);
   RevMemOp *Op = new RevMemOp(Hart, Addr, PAddr, Size,
                               MemOp::MemOpFLUSH, flags);
   Op->setInv(Inv);
@@ -248,6 +266,8 @@ bool RevBasicMemCtrl::sendREADRequest(unsigned Hart,
                                       RevFlag flags){
   if( Size == 0 )
     return true;
+  // buffered stores to the same line must reach memory ahead of the read
+  flushWCLine(Addr, Size);
   RevMemOp *Op = new RevMemOp(Hart, Addr, PAddr, Size, target,
                               MemOp::MemOpREAD, flags);
   Op->setMemReq(req);
@@ -264,6 +284,10 @@ bool RevBasicMemCtrl::sendWRITERequest(unsigned Hart,
                                        RevFlag flags){
   if( Size == 0 )
     return true;
+  if( isWCCandidate(Addr, Size, flags) ){
+    return combineWRITERequest(Hart, Addr, PAddr, Size, buffer, flags);
+  }
+  flushWCLine(Addr, Size);
   RevMemOp *Op = new RevMemOp(Hart, Addr, PAddr, Size, buffer,
                               MemOp::MemOpWRITE, flags);
   rqstQ.push_back(Op);
@@ -291,6 +315,10 @@ bool RevBasicMemCtrl::sendAMORequest(unsigned Hart,
     return true;
   }
 
+  // drain the hart's combined stores along with any buffered copies of the target line
+  flushWC(Hart);
+  flushWCLine(Addr, Size);
+
   // Create a memory operation for the AMO
   // Since this is a read-modify-write operation, the first RevMemOp
   // is a MemOp::MemOpREAD.
@@ -340,6 +368,7 @@ bool RevBasicMemCtrl::sendREADLOCKRequest(unsigned Hart,
                                           RevFlag flags){
   if( Size == 0 )
     return true;
+  flushWCLine(Addr, Size);
   RevMemOp *Op = new RevMemOp(Hart, Addr, PAddr, Size, target,
                               MemOp::MemOpREADLOCK, flags);
   Op->setMemReq(req);
@@ -356,6 +385,7 @@ bool RevBasicMemCtrl::sendWRITELOCKRequest(unsigned Hart,
                                            RevFlag flags){
   if( Size == 0 )
     return true;
+  flushWCLine(Addr, Size);
   RevMemOp *Op = new RevMemOp(Hart, Addr, PAddr, Size, buffer,
                               MemOp::MemOpWRITEUNLOCK, flags);
   rqstQ.push_back(Op);
@@ -370,6 +400,7 @@ bool RevBasicMemCtrl::sendLOADLINKRequest(unsigned Hart,
                                           RevFlag flags){
   if( Size == 0 )
     return true;
+  flushWCLine(Addr, Size);
   RevMemOp *Op = new RevMemOp(Hart, Addr, PAddr, Size,
                               MemOp::MemOpLOADLINK, flags);
   rqstQ.push_back(Op);
@@ -385,6 +416,7 @@ bool RevBasicMemCtrl::sendSTORECONDRequest(unsigned Hart,
                                            RevFlag flags){
   if( Size == 0 )
     return true;
+  flushWCLine(Addr, Size);
   RevMemOp *Op = new RevMemOp(Hart, Addr, PAddr, Size, buffer,
                               MemOp::MemOpSTORECOND, flags);
   rqstQ.push_back(Op);
@@ -401,6 +433,7 @@ bool RevBasicMemCtrl::sendCUSTOMREADRequest(unsigned Hart,
                                             RevFlag flags){
   if( Size == 0 )
     return true;
+  flushWCLine(Addr, Size);
   RevMemOp *Op = new RevMemOp(Hart, Addr, PAddr, Size, target, Opc,
                               MemOp::MemOpCUSTOM, flags);
   rqstQ.push_back(Op);
@@ -417,6 +450,7 @@ bool RevBasicMemCtrl::sendCUSTOMWRITERequest(unsigned Hart,
                                              RevFlag flags){
   if( Size == 0 )
     return true;
+  flushWCLine(Addr, Size);
   RevMemOp *Op = new RevMemOp(Hart, Addr, PAddr, Size, buffer, Opc,
                               MemOp::MemOpCUSTOM, flags);
   rqstQ.push_back(Op);
@@ -425,6 +459,8 @@ bool RevBasicMemCtrl::sendCUSTOMWRITERequest(unsigned Hart,
 }
 
 bool RevBasicMemCtrl::sendFENCE(unsigned Hart){
+  // the fence orders all of the hart's prior stores; drain its buffer first
+  flushWC(Hart);
   RevMemOp *Op = new RevMemOp(Hart, 0x00ull, 0x00ull, 0x00,
                               MemOp::MemOpFENCE, RevFlag::F_NONE);
   rqstQ.push_back(Op);
@@ -432,6 +468,108 @@ bool RevBasicMemCtrl::sendFENCE(unsigned Hart){
   return true;
 }
 
+bool RevBasicMemCtrl::isWCCandidate(uint64_t Addr, uint32_t Size, RevFlag flags){
+  // only cacheable, non-atomic stores contained within a single cache line
+  // are eligible for write combining
+  if( max_wc_stores == 0 || !hasCache || lineSize == 0 ){
+    return false;
+  }else if( RevFlagHas(flags, RevFlag::F_NONCACHEABLE) ||
+            RevFlagHas(flags, RevFlag::F_ATOMIC) ){
+    return false;
+  }
+  return getNumCacheLines(Addr, Size) == 1;
+}
+
+bool RevBasicMemCtrl::combineWRITERequest(unsigned Hart,
+                                          uint64_t Addr,
+                                          uint64_t PAddr,
+                                          uint32_t Size,
+                                          char *buffer,
+                                          RevFlag flags){
+  uint64_t Line = Addr - (Addr % lineSize);
+
+  // a store to a different line (or with different flags) closes the current buffer
+  auto it = wcBuffers.find(Hart);
+  if( it != wcBuffers.end() &&
+      (it->second.Line != Line || it->second.Flags != flags) ){
+    flushWC(Hart);
+  }
+
+  RevWCBuffer& wc = wcBuffers[Hart];
+  if( wc.Stores == 0 ){
+    wc.Line  = Line;
+    wc.PLine = PAddr - (Addr - Line);
+    wc.Flags = flags;
+    wc.ValidBytes = 0;
+    wc.Data.assign(lineSize, 0);
+    wc.Valid.assign(lineSize, false);
+  }
+
+  unsigned Offset = (unsigned)(Addr - Line);
+  for( unsigned i = 0; i < Size; i++ ){
+    wc.Data[Offset+i] = (uint8_t)(buffer[i]);
+    if( !wc.Valid[Offset+i] ){
+      wc.Valid[Offset+i] = true;
+      wc.ValidBytes++;
+    }
+  }
+  wc.Stores++;
+  wc.LastWrite = currentCycle;
+  recordStat(RevBasicMemCtrl::MemCtrlStats::WCStores, 1);
+
+  // flush once the buffer is full
+  if( wc.Stores >= max_wc_stores || wc.ValidBytes == lineSize ){
+    flushWC(Hart);
+  }
+  return true;
+}
+
+void RevBasicMemCtrl::flushWC(unsigned Hart){
+  auto it = wcBuffers.find(Hart);
+  if( it == wcBuffers.end() ){
+    return;
+  }
+
+  // issue one write per contiguous run of valid bytes
+  RevWCBuffer& wc = it->second;
+  unsigned i = 0;
+  while( i < lineSize ){
+    if( !wc.Valid[i] ){
+      i++;
+      continue;
+    }
+    unsigned Start = i;
+    while( i < lineSize && wc.Valid[i] ){
+      i++;
+    }
+    std::vector<uint8_t> Buf(wc.Data.begin()+Start, wc.Data.begin()+i);
+    RevMemOp *Op = new RevMemOp(Hart, wc.Line+Start, wc.PLine+Start,
+                                i-Start, Buf,
+                                MemOp::MemOpWRITE, wc.Flags);
+    rqstQ.push_back(Op);
+    recordStat(RevBasicMemCtrl::MemCtrlStats::WritePending, 1);
+    recordStat(RevBasicMemCtrl::MemCtrlStats::WCWrites, 1);
+  }
+
+  recordStat(RevBasicMemCtrl::MemCtrlStats::WCFlushes, 1);
+  wcBuffers.erase(it);
+}
+
+void RevBasicMemCtrl::flushWCLine(uint64_t Addr, uint32_t Size){
+  if( wcBuffers.empty() ){
+    return;
+  }
+  uint64_t End = Addr + (Size > 0 ? Size : 1);
+  for( auto it = wcBuffers.begin(); it != wcBuffers.end(); ){
+    unsigned Hart = it->first;
+    const RevWCBuffer& wc = it->second;
+    ++it;
+    if( Addr < (wc.Line + lineSize) && wc.Line < End ){
+      flushWC(Hart);
+    }
+  }
+}
+
 void RevBasicMemCtrl::processMemEvent(StandardMem::Request* ev){
   output->verbose(CALL_INFO, 15, 0, "Received memory request event\n");
   if( ev == nullptr ){
@@ -936,6 +1074,115 @@ bool RevBasicMemCtrl::buildCacheMemRqst(RevMemOp *op,
   return true;
 }
 
+bool RevBasicMemCtrl::isAMOOp(RevMemOp *op){
+  auto range = AMOTable.equal_range(op->getAddr());
+  for( auto i = range.first; i != range.second; ++i ){
+    if( std::get<AMOTABLE_MEMOP>(i->second) == op ){
+      return true;
+    }
+  }
+  return false;
+}
+
+bool RevBasicMemCtrl::isMSHRCandidate(RevMemOp *op){
+  // only plain reads that are contained within a single cache line
+  // are eligible for coalescing
+  if( max_mshr == 0 || !hasCache || lineSize == 0 ){
+    return false;
+  }else if( op->getOp() != MemOp::MemOpREAD ){
+    return false;
+  }else if( getNumCacheLines(op->getAddr(), op->getSize()) != 1 ){
+    return false;
+  }
+  return !isAMOOp(op);
+}
+
+void RevBasicMemCtrl::closeMSHR(uint64_t Addr, uint32_t Size){
+  if( mshrOpen.empty() || lineSize == 0 ){
+    return;
+  }
+  uint64_t Line = Addr - (Addr % lineSize);
+  uint64_t End  = Addr + (Size > 0 ? Size : 1);
+  for( ; Line < End; Line += lineSize ){
+    mshrOpen.erase(Line);
+  }
+}
+
+bool RevBasicMemCtrl::buildMSHRRqst(RevMemOp *op, bool &Success){
+  uint64_t Line = op->getAddr() - (op->getAddr() % lineSize);
+
+  // attempt to merge the read into an outstanding line fill
+  auto open = mshrOpen.find(Line);
+  if( open != mshrOpen.end() ){
+    auto& Targets = mshrTargets[open->second];
+    if( Targets.size() < max_mshr_targets ){
+#ifdef _REV_DEBUG_
+      std::cout << "merging read to addr=0x" << std::hex << op->getAddr()
+                << " into MSHR line 0x" << Line << std::dec << std::endl;
+#endif
+      Targets.push_back(op);
+      recordStat(MSHRMerge, 1);
+      Success = true;
+      return true;
+    }
+    // the entry is saturated; retire it from merging and allocate a new fill
+    mshrOpen.erase(open);
+  }
+
+  // no room for a new line fill, dispatch the read as a normal request
+  if( mshrTargets.size() >= max_mshr ){
+    recordStat(MSHRFull, 1);
+    return buildCacheMemRqst(op, Success);
+  }
+
+  if( (max_loads-num_read) < 1 ){
+    Success = false;
+    return true;
+  }
+
+  Success = true;
+  Interfaces::StandardMem::Request *rqst =
+    new Interfaces::StandardMem::Read(Line,
+                                      (uint64_t)(lineSize),
+                                      (StandardMem::Request::flags_t)op->getStdFlags());
+  op->setSplitRqst(1);
+  requests.push_back(rqst->getID());
+  outstanding[rqst->getID()] = op;
+  mshrOpen[Line] = rqst->getID();
+  mshrTargets[rqst->getID()].push_back(op);
+  memIface->send(rqst);
+  recordStat(MSHRAlloc, 1);
+  recordStat(ReadInFlight, 1);
+  num_read++;
+  return true;
+}
+
+void RevBasicMemCtrl::handleMSHRResp(StandardMem::ReadResp* ev,
+                                     std::vector<RevMemOp *>& Targets){
+  uint64_t Line = Targets.front()->getAddr() -
+    (Targets.front()->getAddr() % lineSize);
+
+  for( RevMemOp *op : Targets ){
+    uint8_t *target = static_cast<uint8_t *>(op->getTarget());
+    uint64_t startByte = op->getAddr() - Line;
+    for( unsigned i = 0; i < op->getSize(); i++ ){
+      target[i] = ev->data[startByte+i];
+    }
+    handleFlagResp(op);
+
+    const MemReq& r = op->getMemReq();
+    TRACE_MEM_READ_RESPONSE(op->getSize(), op->getTarget(), &r);
+    r.MarkLoadComplete();
+    delete op;
+  }
+
+  // the line may have already been closed by an intervening write
+  auto open = mshrOpen.find(Line);
+  if( open != mshrOpen.end() && open->second == ev->getID() ){
+    mshrOpen.erase(open);
+  }
+}
+
 bool RevBasicMemCtrl::buildRawMemRqst(RevMemOp *op,
                                       RevFlag TmpFlags){
   Interfaces::StandardMem::Request *rqst = nullptr;
@@ -1078,10 +1325,20 @@ bool RevBasicMemCtrl::buildStandardMemRqst(RevMemOp *op,
   // ALWAYS 1 and we dispatch a single memory requests per
   // RevMemOp
   // ---------------------------------------------------------
+  // Any operation other than a plain read may modify the target lines.
+  // Close the matching MSHR entries so that later reads are not merged
+  // into a line fill that was issued ahead of this operation
+  if( max_mshr > 0 && (op->getOp() != MemOp::MemOpREAD || isAMOOp(op)) ){
+    closeMSHR(op->getAddr(), op->getSize());
+  }
+
   RevFlag TmpFlags;
   if( (hasCache) &&
       (op->isCacheable()) ){
     // cache is enabled and we want to cache the request
+    if( isMSHRCandidate(op) ){
+      return buildMSHRRqst(op, Success);
+    }
     return buildCacheMemRqst(op, Success);
   }else if( (hasCache) && (!op->isCacheable()) ){
     // cache is enabled but the request says not to cache the data
@@ -1185,6 +1442,8 @@ bool RevBasicMemCtrl::processNextRqst(unsigned &t_max_loads,
         t_max_ops = max_ops;
         rqstQ.erase(rqstQ.begin()+i);
         num_fence+=1;
+        // reads behind the fence must not merge into older line fills
+        mshrOpen.clear();
         delete op;
         return true;
       }
@@ -1273,6 +1532,17 @@ void RevBasicMemCtrl::handleReadResp(StandardMem::ReadResp* ev){
     RevMemOp *op = outstanding[ev->getID()];
     if( !op )
       output->fatal(CALL_INFO, -1, "RevMemOp is null in handleReadResp\n" );
+
+    // determine if this is an MSHR line fill with merged reads
+    auto mshr = mshrTargets.find(ev->getID());
+    if( mshr != mshrTargets.end() ){
+      handleMSHRResp(ev, mshr->second);
+      mshrTargets.erase(mshr);
+      outstanding.erase(ev->getID());
+      delete ev;
+      num_read--;
+      return ;
+    }
 #ifdef _REV_DEBUG_
     std::cout << "handleReadResp : id=" << ev->getID() << " @Addr= 0x"
               << std::hex << op->getAddr() << std::dec << std::endl;
@@ -1591,10 +1861,21 @@ uint64_t RevBasicMemCtrl::getTotalRqsts(){
 }
 
 bool RevBasicMemCtrl::outstandingRqsts(){
-  return (requests.size() > 0 );
+  return (requests.size() > 0 ) || !wcBuffers.empty();
 }
 
 bool RevBasicMemCtrl::clockTick(Cycle_t cycle){
+  currentCycle = cycle;
+
+  // flush any write-combining buffers that have gone idle
+  for( auto it = wcBuffers.begin(); it != wcBuffers.end(); ){
+    unsigned Hart = it->first;
+    Cycle_t LastWrite = it->second.LastWrite;
+    ++it;
+    if( (cycle - LastWrite) >= wc_timeout ){
+      flushWC(Hart);
+    }
+  }
 
   // check to see if the top request is a FENCE
   if( num_fence > 0 ){
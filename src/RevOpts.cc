@@ -25,12 +25,18 @@ RevOpts::RevOpts( unsigned NumCores, unsigned NumHarts, const int Verbosity )
   // -- table = internal
   // -- memCosts[core] = 0:10
   // -- prefetch depth = 16
+  // -- lsq depth = 16
+  // -- syscall bandwidth = 8 bytes/cycle
+  // -- syscall table = internal
   for( unsigned i=0; i<numCores; i++ ){
     startAddr.insert( std::pair<unsigned, uint64_t>(i, 0) );
     machine.insert( std::pair<unsigned, std::string>(i, "G") );
     table.insert( std::pair<unsigned, std::string>(i, "_REV_INTERNAL_") );
     memCosts.push_back(InitialPair);
     prefetchDepth.insert( std::pair<unsigned, unsigned>(i, 16) );
+    lsqDepth.insert( std::pair<unsigned, unsigned>(i, 16) );
+    syscallBW.insert( std::pair<unsigned, unsigned>(i, 8) );
+    syscallTable.insert( std::pair<unsigned, std::string>(i, "_REV_INTERNAL_") );
   }
 }
 
@@ -79,6 +85,46 @@ bool RevOpts::InitPrefetchDepth( std::vector<std::string> Depths ){
   return true;
 }
 
+bool RevOpts::InitLSQDepth( std::vector<std::string> Depths ){
+  std::vector<std::string> vstr;
+  for(unsigned i=0; i<Depths.size(); i++ ){
+    std::string s = Depths[i];
+    splitStr(s, ':', vstr);
+    if( vstr.size() != 2 )
+      return false;
+
+    unsigned Core = std::stoul(vstr[0], nullptr, 0);
+    if( Core >= numCores )
+      return false;
+
+    unsigned Depth = std::stoul(vstr[1], nullptr, 0);
+
+    lsqDepth.find(Core)->second = Depth;
+    vstr.clear();
+  }
+  return true;
+}
+
+bool RevOpts::InitSyscallBandwidth( std::vector<std::string> Bandwidths ){
+  std::vector<std::string> vstr;
+  for(unsigned i=0; i<Bandwidths.size(); i++ ){
+    std::string s = Bandwidths[i];
+    splitStr(s, ':', vstr);
+    if( vstr.size() != 2 )
+      return false;
+
+    unsigned Core = std::stoul(vstr[0], nullptr, 0);
+    if( Core >= numCores )
+      return false;
+
+    unsigned BW = std::stoul(vstr[1], nullptr, 0);
+
+    syscallBW.find(Core)->second = BW;
+    vstr.clear();
+  }
+  return true;
+}
+
 bool RevOpts::InitStartAddrs( std::vector<std::string> StartAddrs ){
   std::vector<std::string> vstr;
 
@@ -191,6 +237,24 @@ bool RevOpts::InitInstTables( std::vector<std::string> InstTables ){
   return true;
 }
 
+bool RevOpts::InitSyscallTables( std::vector<std::string> SyscallTables ){
+  std::vector<std::string> vstr;
+  for( unsigned i=0; i<SyscallTables.size(); i++ ){
+    std::string s = SyscallTables[i];
+    splitStr(s, ':', vstr);
+    if( vstr.size() != 2 )
+      return false;
+
+    unsigned Core = std::stoi(vstr[0], nullptr, 0);
+    if( Core >= numCores )
+      return false;
+
+    syscallTable.at(Core) = vstr[1];
+    vstr.clear();
+  }
+  return true;
+}
+
 bool RevOpts::InitMemCosts( std::vector<std::string> MemCosts ){
   std::vector<std::string> vstr;
 
@@ -225,6 +289,28 @@ bool RevOpts::GetPrefetchDepth( unsigned Core, unsigned &Depth ){
   return true;
 }
 
+bool RevOpts::GetLSQDepth( unsigned Core, unsigned &Depth ){
+  if( Core > numCores )
+    return false;
+
+  if( lsqDepth.find(Core) == lsqDepth.end() )
+    return false;
+
+  Depth = lsqDepth.at(Core);
+  return true;
+}
+
+bool RevOpts::GetSyscallBandwidth( unsigned Core, unsigned &Bandwidth ){
+  if( Core > numCores )
+    return false;
+
+  if( syscallBW.find(Core) == syscallBW.end() )
+    return false;
+
+  Bandwidth = syscallBW.at(Core);
+  return true;
+}
+
 bool RevOpts::GetStartAddr( unsigned Core, uint64_t &StartAddr ){
   if( Core > numCores )
     return false;
@@ -263,6 +349,14 @@ bool RevOpts::GetInstTable( unsigned Core, std::string &Table ){
   return true;
 }
 
+bool RevOpts::GetSyscallTable( unsigned Core, std::string &Table ){
+  if( Core >= numCores )
+    return false;
+
+  Table = syscallTable.at(Core);
+  return true;
+}
+
 bool RevOpts::GetMemCost( unsigned Core, unsigned &Min, unsigned &Max ){
   if( Core > numCores )
     return false;
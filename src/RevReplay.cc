@@ -0,0 +1,77 @@
+//
+// _RevReplay_cc_
+//
+// Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#include "RevReplay.h"
+#include <cstring>
+
+namespace SST::RevCPU{
+
+RevReplay::RevReplay(const std::string& Path, bool Replaying) : Replaying(Replaying) {
+  if( Replaying ){
+    In.open(Path, std::ios::binary);
+    char Hdr[sizeof(Magic)];
+    Good = In.read(Hdr, sizeof(Hdr)) && !memcmp(Hdr, Magic, sizeof(Magic));
+  }else{
+    Out.open(Path, std::ios::binary | std::ios::trunc);
+    Good = Out.write(Magic, sizeof(Magic)).good();
+  }
+}
+
+void RevReplay::PutVarint(uint64_t V){
+  while( V >= 0x80 ){
+    Out.put(char(V | 0x80));
+    V >>= 7;
+  }
+  Out.put(char(V));
+}
+
+bool RevReplay::GetVarint(uint64_t& V){
+  V = 0;
+  for( unsigned Shift = 0; Shift < 64; Shift += 7 ){
+    int c = In.get();
+    if( c == EOF )
+      return false;
+    V |= uint64_t(c & 0x7f) << Shift;
+    if( !(c & 0x80) )
+      return true;
+  }
+  return false;
+}
+
+void RevReplay::Put(Event E, uint64_t Code, int64_t Value, const void *Data, size_t Len){
+  Out.put(char(E));
+  PutVarint(Code);
+  // zigzag keeps small negative errnos short
+  PutVarint((uint64_t(Value) << 1) ^ uint64_t(Value >> 63));
+  PutVarint(Len);
+  if( Len )
+    Out.write(static_cast<const char*>(Data), std::streamsize(Len));
+  Count++;
+}
+
+bool RevReplay::Get(Event E, uint64_t Code, int64_t& Value, std::vector<char> *Data){
+  int Type = In.get();
+  uint64_t LogCode, ZigZag, Len;
+  if( Type != int(E) || !GetVarint(LogCode) || LogCode != Code ||
+      !GetVarint(ZigZag) || !GetVarint(Len) )
+    return false;
+
+  Value = int64_t(ZigZag >> 1) ^ -int64_t(ZigZag & 1);
+  if( Data ){
+    Data->resize(Len);
+    In.read(Data->data(), std::streamsize(Len));
+  }else{
+    In.ignore(std::streamsize(Len));
+  }
+  Count++;
+  return bool(In);
+}
+
+} // namespace SST::RevCPU
@@ -3,61 +3,390 @@
 #include "RevCommon.h"
 #include "RevMem.h"
 #include <bitset>
+#include <cerrno>
+#include <climits>
 #include <filesystem>
+#include <sys/stat.h>
+#include <sys/syscall.h>
 #include <sys/xattr.h>
 
 namespace SST::RevCPU{
 
 /// Parse a string for an ECALL starting at address straddr, updating the state
 /// as characters are read, and call action() when the end of string is reached.
+/// Without memHierarchy the string is scanned in place a page at a time; with
+/// memHierarchy it is fetched a cache line per request.  The copy is charged
+/// through ChargeEcallBytes once the terminator is found.
 EcallStatus RevProc::EcallLoadAndParseString(RevInst& inst,
                                              uint64_t straddr,
                                              std::function<void()> action){
-  auto  rtval = EcallStatus::ERROR;
   auto& EcallState = Harts.at(HartToExecID)->GetEcallState();
 
-  if( RegFile->GetLSQueue()->count(LSQHash(RevReg::a0, RevRegClass::RegGPR, HartToExecID)) > 0 ){
-    rtval = EcallStatus::CONTINUE;
-  } else {
-    // we don't know how long the path string is so read a byte (char)
-    // at a time and search for the string terminator character '\0'
-    if(EcallState.bytesRead != 0){
-      EcallState.string += std::string_view(EcallState.buf.data(), EcallState.bytesRead);
-      EcallState.bytesRead = 0;
+  if( RegFile->HasPendingLoad(uint64_t(RevReg::a0), RevRegClass::RegGPR) ){
+    return EcallStatus::CONTINUE;
+  }
+
+  // append the chunk returned by the previous memory request, up to and
+  // including the terminator
+  if(EcallState.bytesRead != 0){
+    std::string_view chunk(EcallState.buf.data(), EcallState.bytesRead);
+    size_t nul = chunk.find('\0');
+    EcallState.string += nul == std::string_view::npos ? chunk : chunk.substr(0, nul+1);
+    EcallState.bytesRead = 0;
+  }
+
+  // We store the 0-terminator byte in EcallState.string to distinguish an empty
+  // C string from no data read at all. If we read an empty string in the
+  // program, EcallState.string.size() == 1 with front() == back() == '\0'. If no
+  // data has been read yet, EcallState.string.size() == 0.
+  while(EcallState.string.empty() || EcallState.string.back()){
+    // scan the remainder of the page directly in guest memory
+    size_t len;
+    const char *host = mem->GetHostPtr(straddr + EcallState.string.size(), len);
+    if( !host )
+      break;
+    const void *nul = memchr(host, '\0', len);
+    EcallState.string.append(host, nul ? static_cast<const char*>(nul) - host + 1 : len);
+  }
+
+  if(EcallState.string.size() && !EcallState.string.back()){
+    //found the null terminator - we're done
+    ChargeEcallBytes(EcallState.string.size());
+
+    // action is usually passed in as a lambda with local code and captures
+    // from the caller, such as performing a syscall using EcallState.string.
+    action();
+
+    EcallState.string.clear();   //reset the ECALL buffers
+    EcallState.bytesRead = 0;
+
+    DependencyClear(HartToExecID, RevReg::a0, false);
+    return EcallStatus::SUCCESS;
+  }
+
+  // memHierarchy: fetch the next chunk of the string without crossing a
+  // cache line (or a buffer-sized block, which never crosses a page)
+  uint64_t addr = straddr + EcallState.string.size();
+  size_t nbytes = EcallState.buf.size() - (addr % EcallState.buf.size());
+  if( unsigned line = mem->getLineSize() ){
+    nbytes = std::min<size_t>(nbytes, line - (addr % line));
+  }
+
+  MemReq req{addr, RevReg::a0,
+             RevRegClass::RegGPR, HartToExecID, MemOp::MemOpREAD,
+             true, RegFile->GetMarkLoadComplete()};
+  RegFile->LSQInsert(req);
+  mem->ReadMem(HartToExecID, addr, nbytes, EcallState.buf.data(), req, RevFlag::F_NONE);
+  EcallState.bytesRead = nbytes;
+  DependencySet(HartToExecID, RevReg::a0, false);
+  return EcallStatus::CONTINUE;
+}
+
+/// Read nbytes of guest memory starting at addr into EcallState.string through
+/// the memory hierarchy, a cache line per request, and call action() once the
+/// whole buffer has arrived.  Used when guest pages are not directly
+/// addressable by the host.
+EcallStatus RevProc::EcallLoadBuffer(uint64_t addr,
+                                     uint64_t nbytes,
+                                     std::function<void()> action){
+  auto& EcallState = Harts.at(HartToExecID)->GetEcallState();
+
+  if( RegFile->HasPendingLoad(uint64_t(RevReg::a0), RevRegClass::RegGPR) ){
+    return EcallStatus::CONTINUE;
+  }
+
+  if(EcallState.bytesRead != 0){
+    EcallState.string += std::string_view(EcallState.buf.data(), EcallState.bytesRead);
+    EcallState.bytesRead = 0;
+  }
+
+  uint64_t nleft = nbytes - EcallState.string.size();
+  if(nleft == 0){
+    // clear the dependency first; action() may deschedule the thread
+    DependencyClear(HartToExecID, RevReg::a0, false);
+    ChargeEcallBytes(nbytes);
+    action();
+    EcallState.clear();
+    return EcallStatus::SUCCESS;
+  }
+
+  uint64_t next = addr + EcallState.string.size();
+  size_t chunk = EcallState.buf.size() - (next % EcallState.buf.size());
+  if( unsigned line = mem->getLineSize() ){
+    chunk = std::min<size_t>(chunk, line - (next % line));
+  }
+  chunk = std::min<uint64_t>(chunk, nleft);
+
+  MemReq req{next, RevReg::a0, RevRegClass::RegGPR, HartToExecID,
+             MemOp::MemOpREAD, true, RegFile->GetMarkLoadComplete()};
+  RegFile->LSQInsert(req);
+  mem->ReadMem(HartToExecID, next, chunk, EcallState.buf.data(), req, RevFlag::F_NONE);
+  EcallState.bytesRead = chunk;
+  DependencySet(HartToExecID, RevReg::a0, false);
+  return EcallStatus::CONTINUE;
+}
+
+/// Translate the guest range [Addr, Addr+Len) into host iovecs that point
+/// straight into RevMem pages, merging pieces that are contiguous on the host.
+/// Returns false, leaving Iov unchanged, when guest memory is only reachable
+/// through memHierarchy.
+bool RevProc::EcallHostIovecs(uint64_t Addr, uint64_t Len, std::vector<iovec>& Iov){
+  const size_t first = Iov.size();
+  while( Len ){
+    size_t avail;
+    char *host = mem->GetHostPtr(Addr, avail);
+    if( !host ){
+      Iov.resize(first);
+      return false;
+    }
+    size_t chunk = std::min<uint64_t>(avail, Len);
+    if( Iov.size() > first &&
+        static_cast<char*>(Iov.back().iov_base) + Iov.back().iov_len == host ){
+      Iov.back().iov_len += chunk;
+    }else{
+      Iov.push_back({host, chunk});
     }
+    Addr += chunk;
+    Len  -= chunk;
+  }
+  return true;
+}
+
+/// Copy Len bytes of guest memory at Addr into Dst
+bool RevProc::EcallCopyFromGuest(uint64_t Addr, void *Dst, size_t Len){
+  std::vector<iovec> Iov;
+  if( !EcallHostIovecs(Addr, Len, Iov) )
+    return false;
+  char *d = static_cast<char*>(Dst);
+  for( const auto& v : Iov ){
+    memcpy(d, v.iov_base, v.iov_len);
+    d += v.iov_len;
+  }
+  return true;
+}
+
+/// Read the guest's array of VLen struct iovec at VecAddr and append the host
+/// iovecs for each of its buffers to Iov.  Returns the total number of bytes
+/// described, -EINVAL for a malformed array, or -ENOSYS when guest memory is
+/// not directly addressable.
+ssize_t RevProc::EcallGuestIovecs(uint64_t VecAddr, uint64_t VLen, std::vector<iovec>& Iov,
+                                  std::vector<std::pair<uint64_t, uint64_t>>* Bufs){
+  if( VLen > IOV_MAX )
+    return -EINVAL;
+
+  // struct iovec is a pointer and a size_t in the guest ABI
+  const size_t xlen = feature->IsRV32() ? sizeof(uint32_t) : sizeof(uint64_t);
+  std::vector<unsigned char> raw(VLen * 2 * xlen);
+  if( !EcallCopyFromGuest(VecAddr, raw.data(), raw.size()) )
+    return -ENOSYS;
+
+  uint64_t total = 0;
+  for( uint64_t i = 0; i < VLen; i++ ){
+    uint64_t base = 0, len = 0;
+    memcpy(&base, &raw[2 * i * xlen], xlen);
+    memcpy(&len, &raw[(2 * i + 1) * xlen], xlen);
+    total += len;
+    if( total > SSIZE_MAX )
+      return -EINVAL;
+    if( !EcallHostIovecs(base, len, Iov) )
+      return -ENOSYS;
+    if( Bufs )
+      Bufs->emplace_back(base, len);
+  }
+  return ssize_t(total);
+}
+
+/// A direct host read bypasses WriteMem, which revokes the reservation on
+/// the address it writes; do the same for each buffer that received data
+void RevProc::EcallRevokeFutures(const std::vector<std::pair<uint64_t, uint64_t>>& Bufs, ssize_t Len){
+  for( const auto& [Base, BufLen] : Bufs ){
+    if( Len <= 0 )
+      break;
+    if( BufLen ){
+      mem->RevokeFuture(Base);
+      Len -= ssize_t(BufLen);
+    }
+  }
+}
 
-    // We store the 0-terminator byte in EcallState.string to distinguish an empty
-    // C string from no data read at all. If we read an empty string in the
-    // program, EcallState.string.size() == 1 with front() == back() == '\0'. If no
-    // data has been read yet, EcallState.string.size() == 0.
-    if(EcallState.string.size() && !EcallState.string.back()){
-      //found the null terminator - we're done
-      // action is usually passed in as a lambda with local code and captures
-      // from the caller, such as performing a syscall using EcallState.string.
-      action();
-
-      EcallState.string.clear();   //reset the ECALL buffers
-      EcallState.bytesRead = 0;
-
-      DependencyClear(HartToExecID, RevReg::a0, false);
-      rtval = EcallStatus::SUCCESS;
+/// Assemble a 64-bit file offset passed in Lo (and Hi on RV32)
+off_t RevProc::EcallOffset(RevReg Lo, RevReg Hi){
+  if( feature->IsRV32() )
+    return off_t(RegFile->GetX<uint32_t>(Lo) | uint64_t(RegFile->GetX<uint32_t>(Hi)) << 32);
+  return off_t(RegFile->GetX<uint64_t>(Lo));
+}
+
+/// Read up to Len bytes from the host file descriptor straight into the guest
+/// pages backing Addr, falling back to a staged read under memHierarchy.
+/// Only the bytes actually read are written to guest memory.
+ssize_t RevProc::EcallReadInto(int fd, uint64_t Addr, uint64_t Len, const off_t *Pos){
+  std::vector<iovec> iov;
+  ssize_t rc;
+  if( EcallHostIovecs(Addr, Len, iov) ){
+    rc = EcallHostIO(false, fd, iov, Pos);
+    if( rc > 0 )
+      mem->RevokeFuture(Addr);
+  }else{
+    rc = EcallStagedRead(fd, Addr, Len, Pos);
+  }
+  ChargeEcallBytes(rc > 0 ? rc : 0);
+  return rc;
+}
+
+/// Transfer Iov to (Write) or from the host file descriptor with as few
+/// writev/readv calls (pwritev/preadv when Pos is non-null) as IOV_MAX allows,
+/// stopping at the first short transfer.  Returns the number of bytes
+/// transferred or a negative errno.
+static ssize_t EcallTransfer(bool Write, int fd, const std::vector<iovec>& Iov, const off_t *Pos){
+  ssize_t total = 0;
+  for( size_t i = 0; i < Iov.size(); ){
+    int cnt = int(std::min<size_t>(Iov.size() - i, IOV_MAX));
+    ssize_t want = 0;
+    for( int j = 0; j < cnt; j++ )
+      want += Iov[i+j].iov_len;
+
+    ssize_t rc;
+    if( Write ){
+      rc = Pos ? pwritev(fd, &Iov[i], cnt, *Pos + total) : writev(fd, &Iov[i], cnt);
     }else{
-      //We are in the middle of the string - read one byte
-      MemReq req{straddr + EcallState.string.size(), RevReg::a0,
-                 RevRegClass::RegGPR, HartToExecID, MemOp::MemOpREAD,
-                 true, [=](const MemReq& req){this->MarkLoadComplete(req);}};
-      LSQueue->insert(req.LSQHashPair());
-      mem->ReadVal(HartToExecID,
-                  straddr + EcallState.string.size(),
-                  EcallState.buf.data(),
-                  req,
-                   RevFlag::F_NONE);
-      EcallState.bytesRead = 1;
-      DependencySet(HartToExecID, RevReg::a0, false);
-      rtval = EcallStatus::CONTINUE;
+      rc = Pos ? preadv(fd, &Iov[i], cnt, *Pos + total) : readv(fd, &Iov[i], cnt);
     }
+    if( rc < 0 )
+      return total ? total : -errno;
+    total += rc;
+    if( rc < want )
+      break;
+    i += cnt;
   }
-  return rtval;
+  return total;
+}
+
+/// Make the host call Call on behalf of the current ECALL.  When recording,
+/// its result and the bytes it left in Data are logged; when replaying, Call
+/// is skipped and the logged result and bytes are returned instead.
+int64_t RevProc::EcallHost(const std::function<int64_t()>& Call, std::vector<char>* Data){
+  if( !replay )
+    return Call();
+
+  uint64_t Code = RegFile->GetX<uint64_t>(RevReg::a7);
+  int64_t rc;
+  if( replay->IsReplaying() ){
+    if( !replay->Get(RevReplay::Event::Syscall, Code, rc, Data) )
+      output->fatal(CALL_INFO, -1,
+                    "Error: replay diverged from the log at event %" PRIu64 " (syscall %" PRIu64 ")\n",
+                    replay->GetCount(), Code);
+    return rc;
+  }
+  rc = Call();
+  replay->Put(RevReplay::Event::Syscall, Code, rc,
+              Data ? Data->data() : nullptr, Data ? Data->size() : 0);
+  return rc;
+}
+
+/// Transfer Iov to (Write) or from the host file descriptor.  Descriptors of
+/// the in-memory filesystem are served by RevVFS, and host transfers go
+/// through the record/replay log.  Returns the number of bytes transferred
+/// or a negative errno.
+ssize_t RevProc::EcallHostIO(bool Write, int fd, const std::vector<iovec>& Iov, const off_t *Pos){
+  if( vfs && vfs->IsOpen(fd) )
+    return vfs->IO(Write, fd, Iov, Pos);
+  if( !replay )
+    return EcallTransfer(Write, fd, Iov, Pos);
+
+  // a read logs the bytes it returned so that a replay can reproduce them
+  std::vector<char> Data;
+  ssize_t rc = EcallHost([&]{
+    ssize_t n = EcallTransfer(Write, fd, Iov, Pos);
+    for( size_t i = 0, left = !Write && n > 0 ? n : 0; left; i++ ){
+      size_t c = std::min(left, Iov[i].iov_len);
+      Data.insert(Data.end(), static_cast<char*>(Iov[i].iov_base), static_cast<char*>(Iov[i].iov_base) + c);
+      left -= c;
+    }
+    return int64_t(n);
+  }, Write ? nullptr : &Data);
+
+  if( replay->IsReplaying() ){
+    for( size_t i = 0, done = 0; done < Data.size() && i < Iov.size(); i++ ){
+      size_t c = std::min(Data.size() - done, Iov[i].iov_len);
+      memcpy(Iov[i].iov_base, &Data[done], c);
+      done += c;
+    }
+  }
+  return rc;
+}
+
+/// Read up to Len bytes from the host file descriptor into guest memory at
+/// Addr when guest pages are not directly addressable.  The data is staged
+/// through a bounded buffer and only the bytes actually read are written.
+ssize_t RevProc::EcallStagedRead(int fd, uint64_t Addr, uint64_t Len, const off_t *Pos){
+  std::vector<char> TmpBuf(std::min<uint64_t>(Len, 64 * 1024));
+  ssize_t total = 0;
+  while( uint64_t(total) < Len ){
+    size_t chunk = std::min<uint64_t>(TmpBuf.size(), Len - total);
+    off_t at = Pos ? *Pos + total : 0;
+    ssize_t rc = EcallHostIO(false, fd, {{TmpBuf.data(), chunk}}, Pos ? &at : nullptr);
+    if( rc < 0 )
+      return total ? total : rc;
+    if( rc == 0 )
+      break;
+    mem->WriteMem(HartToExecID, Addr + total, rc, TmpBuf.data());
+    total += rc;
+    if( size_t(rc) < chunk )
+      break;
+  }
+  return total;
+}
+
+/// Convert a guest struct __kernel_timespec to nanoseconds, saturating at
+/// UINT64_MAX - 1.  Returns false if the timespec is malformed.
+static bool EcallTimespecToNanos(const char* ts, uint64_t& Nanos){
+  int64_t sec, nsec;
+  memcpy(&sec, ts, sizeof(sec));
+  memcpy(&nsec, ts + sizeof(sec), sizeof(nsec));
+  if( sec < 0 || nsec < 0 || nsec >= 1000000000 )
+    return false;
+  if( uint64_t(sec) >= (UINT64_MAX - 1) / 1000000000ull )
+    Nanos = UINT64_MAX - 1;
+  else
+    Nanos = uint64_t(sec) * 1000000000ull + uint64_t(nsec);
+  return true;
+}
+
+// Guest (RISC-V Linux) struct iocb and struct io_event layout
+namespace RevIocb{
+  constexpr size_t   SIZE        = 64;
+  constexpr size_t   DATA        = 0;    // __u64 aio_data
+  constexpr size_t   OPCODE      = 16;   // __u16 aio_lio_opcode
+  constexpr size_t   FILDES      = 20;   // __u32 aio_fildes
+  constexpr size_t   BUF         = 24;   // __u64 aio_buf
+  constexpr size_t   NBYTES      = 32;   // __u64 aio_nbytes
+  constexpr size_t   OFFSET      = 40;   // __s64 aio_offset
+  constexpr uint16_t PREAD       = 0;
+  constexpr uint16_t PWRITE      = 1;
+  constexpr uint16_t FSYNC       = 2;
+  constexpr uint16_t FDSYNC      = 3;
+  constexpr uint16_t NOOP        = 6;
+  constexpr uint16_t PREADV      = 7;
+  constexpr uint16_t PWRITEV     = 8;
+}
+static_assert(sizeof(RevAIO::Event) == 32, "RevAIO::Event must match struct io_event");
+
+// Guest (RISC-V Linux, asm-generic) struct stat layout
+namespace RevStat{
+  constexpr size_t SIZE    = 128;
+  constexpr size_t DEV     = 0;     // unsigned long st_dev
+  constexpr size_t INO     = 8;     // unsigned long st_ino
+  constexpr size_t MODE    = 16;    // unsigned int  st_mode
+  constexpr size_t NLINK   = 20;    // unsigned int  st_nlink
+  constexpr size_t UID     = 24;    // unsigned int  st_uid
+  constexpr size_t GID     = 28;    // unsigned int  st_gid
+  constexpr size_t RDEV    = 32;    // unsigned long st_rdev
+  constexpr size_t FSIZE   = 48;    // long          st_size
+  constexpr size_t BLKSIZE = 56;    // int           st_blksize
+  constexpr size_t BLOCKS  = 64;    // long          st_blocks
+  constexpr size_t ATIME   = 72;    // long          st_atime
+  constexpr size_t MTIME   = 88;    // long          st_mtime
+  constexpr size_t CTIME   = 104;   // long          st_ctime
 }
 
 // 0, rev_io_setup(unsigned nr_reqs, aio_context_t  *ctx)
@@ -65,6 +394,20 @@ EcallStatus RevProc::ECALL_io_setup(RevInst& inst){
   output->verbose(CALL_INFO, 2, 0,
                   "ECALL: io_setup called by thread %" PRIu32
                   " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
+  auto nr = RegFile->GetX<uint32_t>(RevReg::a0);
+  auto ctxp = RegFile->GetX<uint64_t>(RevReg::a1);
+
+  // aio_context_t is an unsigned long that must be zero on entry
+  const size_t xlen = feature->IsRV32() ? sizeof(uint32_t) : sizeof(uint64_t);
+  uint64_t ctx = 0;
+  if( nr == 0 || !EcallCopyFromGuest(ctxp, &ctx, xlen) || ctx != 0 ){
+    RegFile->SetX(RevReg::a0, -EINVAL);
+    return EcallStatus::SUCCESS;
+  }
+
+  ctx = aio->Setup(nr);
+  mem->WriteMem(HartToExecID, ctxp, xlen, &ctx);
+  RegFile->SetX(RevReg::a0, 0);
   return EcallStatus::SUCCESS;
 }
 
@@ -73,6 +416,8 @@ EcallStatus RevProc::ECALL_io_destroy(RevInst& inst){
   output->verbose(CALL_INFO, 2, 0,
                   "ECALL: io_destroy called by thread %" PRIu32
                   " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
+  auto ctx = RegFile->GetX<uint64_t>(RevReg::a0);
+  RegFile->SetX(RevReg::a0, aio->Destroy(ctx) ? 0 : -EINVAL);
   return EcallStatus::SUCCESS;
 }
 
@@ -81,6 +426,97 @@ EcallStatus RevProc::ECALL_io_submit(RevInst& inst){
   output->verbose(CALL_INFO, 2, 0,
                   "ECALL: io_submit called by thread %" PRIu32
                   " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
+  auto ctx = RegFile->GetX<uint64_t>(RevReg::a0);
+  auto nr = RegFile->GetX<int64_t>(RevReg::a1);
+  auto iocbpp = RegFile->GetX<uint64_t>(RevReg::a2);
+
+  if( nr < 0 || !aio->Valid(ctx) ){
+    RegFile->SetX(RevReg::a0, -EINVAL);
+    return EcallStatus::SUCCESS;
+  }
+  // as on Linux, no more than the context can hold are looked at
+  nr = std::min<int64_t>(nr, aio->Capacity(ctx));
+  if( nr == 0 ){
+    RegFile->SetX(RevReg::a0, 0);
+    return EcallStatus::SUCCESS;
+  }
+
+  // The host workers transfer straight to and from guest pages, which
+  // requires them to be host-addressable
+  const size_t xlen = feature->IsRV32() ? sizeof(uint32_t) : sizeof(uint64_t);
+  std::vector<unsigned char> ptrs(nr * xlen);
+  if( !EcallCopyFromGuest(iocbpp, ptrs.data(), ptrs.size()) ){
+    RegFile->SetX(RevReg::a0, -ENOSYS);
+    return EcallStatus::SUCCESS;
+  }
+
+  int64_t submitted = 0;
+  int rc = 0;
+  for( int64_t i = 0; i < nr && rc == 0; i++ ){
+    uint64_t obj = 0;
+    memcpy(&obj, &ptrs[i * xlen], xlen);
+
+    unsigned char iocb[RevIocb::SIZE];
+    if( !EcallCopyFromGuest(obj, iocb, sizeof(iocb)) ){
+      rc = -EFAULT;
+      break;
+    }
+    uint64_t data, buf, nbytes;
+    int64_t offset;
+    uint16_t opcode;
+    uint32_t fd;
+    memcpy(&data, &iocb[RevIocb::DATA], sizeof(data));
+    memcpy(&opcode, &iocb[RevIocb::OPCODE], sizeof(opcode));
+    memcpy(&fd, &iocb[RevIocb::FILDES], sizeof(fd));
+    memcpy(&buf, &iocb[RevIocb::BUF], sizeof(buf));
+    memcpy(&nbytes, &iocb[RevIocb::NBYTES], sizeof(nbytes));
+    memcpy(&offset, &iocb[RevIocb::OFFSET], sizeof(offset));
+
+    // the workers use host descriptors; RevVFS files have none
+    if( int(fd) >= RevVFS::FirstFD ){
+      rc = vfs && vfs->IsOpen(int(fd)) ? -EINVAL : -EBADF;
+      continue;
+    }
+
+    std::vector<iovec> iov;
+    RevAIO::Op op;
+    uint64_t bytes = 0;
+    switch( opcode ){
+    case RevIocb::PREAD:
+    case RevIocb::PWRITE:
+      op = opcode == RevIocb::PREAD ? RevAIO::Op::Read : RevAIO::Op::Write;
+      if( !EcallHostIovecs(buf, nbytes, iov) ){
+        rc = -EFAULT;
+        continue;
+      }
+      bytes = nbytes;
+      break;
+    case RevIocb::PREADV:
+    case RevIocb::PWRITEV: {
+      op = opcode == RevIocb::PREADV ? RevAIO::Op::Read : RevAIO::Op::Write;
+      ssize_t total = EcallGuestIovecs(buf, nbytes, iov);
+      if( total < 0 ){
+        rc = int(total);
+        continue;
+      }
+      bytes = uint64_t(total);
+      break;
+    }
+    case RevIocb::FSYNC:  op = RevAIO::Op::Fsync;  break;
+    case RevIocb::FDSYNC: op = RevAIO::Op::Fdsync; break;
+    case RevIocb::NOOP:   op = RevAIO::Op::Noop;   break;
+    default:
+      rc = -EINVAL;
+      continue;
+    }
+
+    rc = aio->Submit(ctx, data, obj, op, int(fd), std::move(iov), off_t(offset), bytes);
+    if( rc == 0 )
+      submitted++;
+  }
+
+  // errors are only reported when nothing could be submitted
+  RegFile->SetX(RevReg::a0, submitted ? submitted : rc);
   return EcallStatus::SUCCESS;
 }
 
@@ -89,14 +525,72 @@ EcallStatus RevProc::ECALL_io_cancel(RevInst& inst){
   output->verbose(CALL_INFO, 2, 0,
                   "ECALL: io_cancel called by thread %" PRIu32
                   " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
+  auto ctx = RegFile->GetX<uint64_t>(RevReg::a0);
+  auto obj = RegFile->GetX<uint64_t>(RevReg::a1);
+  auto result = RegFile->GetX<uint64_t>(RevReg::a2);
+
+  if( !aio->Valid(ctx) ){
+    RegFile->SetX(RevReg::a0, -EINVAL);
+    return EcallStatus::SUCCESS;
+  }
+
+  // only requests that no host worker has started can be cancelled
+  RevAIO::Event ev;
+  if( !aio->Cancel(ctx, obj, ev) ){
+    RegFile->SetX(RevReg::a0, -EAGAIN);
+    return EcallStatus::SUCCESS;
+  }
+  mem->WriteMem(HartToExecID, result, sizeof(ev), &ev);
+  RegFile->SetX(RevReg::a0, 0);
   return EcallStatus::SUCCESS;
 }
 
 // 4, rev_io_getevents(aio_context_t ctx_id, long min_nr, long nr, struct io_event  *events, struct __kernel_timespec  *timeout)
 EcallStatus RevProc::ECALL_io_getevents(RevInst& inst){
-  output->verbose(CALL_INFO, 2, 0,
-                  "ECALL: io_getevents called by thread %" PRIu32
-                  " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
+  auto& EcallState = Harts.at(HartToExecID)->GetEcallState();
+  auto ctx = RegFile->GetX<uint64_t>(RevReg::a0);
+  auto min_nr = RegFile->GetX<int64_t>(RevReg::a1);
+  auto nr = RegFile->GetX<int64_t>(RevReg::a2);
+  auto events = RegFile->GetX<uint64_t>(RevReg::a3);
+  auto timeout = RegFile->GetX<uint64_t>(RevReg::a4);
+
+  if( EcallState.deadline == 0 ){
+    output->verbose(CALL_INFO, 2, 0,
+                    "ECALL: io_getevents called by thread %" PRIu32
+                    " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
+    if( min_nr < 0 || nr < min_nr || !aio->Valid(ctx) ){
+      RegFile->SetX(RevReg::a0, -EINVAL);
+      return EcallStatus::SUCCESS;
+    }
+
+    // wait forever without a timeout
+    EcallState.deadline = UINT64_MAX;
+    char ts[16];
+    if( timeout && EcallCopyFromGuest(timeout, ts, sizeof(ts)) ){
+      uint64_t nanos;
+      if( !EcallTimespecToNanos(ts, nanos) ){
+        RegFile->SetX(RevReg::a0, -EINVAL);
+        EcallState.clear();
+        return EcallStatus::SUCCESS;
+      }
+      uint64_t cycles = timeConverter ? EcallNanosToCycles(nanos) : 0;
+      EcallState.deadline = aio->GetCycle() + std::min(cycles, UINT64_MAX - 1 - aio->GetCycle());
+    }
+  }
+
+  // keep re-executing the ECALL until enough completions are due
+  if( aio->Ready(ctx) < size_t(min_nr) && aio->GetCycle() < EcallState.deadline &&
+      aio->Valid(ctx) ){
+    return EcallStatus::CONTINUE;
+  }
+
+  std::vector<RevAIO::Event> done;
+  aio->Reap(ctx, size_t(nr), done);
+  if( !done.empty() ){
+    mem->WriteMem(HartToExecID, events, done.size() * sizeof(RevAIO::Event), done.data());
+  }
+  RegFile->SetX(RevReg::a0, done.size());
+  EcallState.clear();
   return EcallStatus::SUCCESS;
 }
 
@@ -254,8 +748,13 @@ EcallStatus RevProc::ECALL_fremovexattr(RevInst& inst){
 EcallStatus RevProc::ECALL_getcwd(RevInst& inst){
   auto BufAddr = RegFile->GetX<uint64_t>(RevReg::a0);
   auto size = RegFile->GetX<uint64_t>(RevReg::a1);
-  auto CWD = std::filesystem::current_path();
-  mem->WriteMem(HartToExecID, BufAddr, size, CWD.c_str());
+  std::vector<char> CWD;
+  EcallHost([&]{
+    std::string Path = std::filesystem::current_path().string();
+    CWD.assign(Path.c_str(), Path.c_str() + Path.size() + 1);
+    return int64_t(0);
+  }, &CWD);
+  mem->WriteMem(HartToExecID, BufAddr, std::min<uint64_t>(size, CWD.size()), CWD.data());
 
   // Returns null-terminated string in buf
   // (no need to set x10 since it's already got BufAddr)
@@ -402,8 +901,12 @@ EcallStatus RevProc::ECALL_mkdirat(RevInst& inst){
   auto mode = RegFile->GetX<unsigned short>(RevReg::a2);
 
   auto action = [&]{
+    if( vfs ){
+      RegFile->SetX(RevReg::a0, vfs->Mkdir(dirfd, ECALL.string, mode));
+      return;
+    }
     // Do the mkdirat on the host
-    int rc = mkdirat(dirfd, ECALL.string.c_str(), mode);
+    int rc = int(EcallHost([&]{ return int64_t(mkdirat(dirfd, ECALL.string.c_str(), mode)); }));
     RegFile->SetX(RevReg::a0, rc);
   };
   return EcallLoadAndParseString(inst, path, action);
@@ -411,11 +914,28 @@ EcallStatus RevProc::ECALL_mkdirat(RevInst& inst){
 
 // 35, rev_unlinkat(int dfd, const char  * pathname, int flag)
 EcallStatus RevProc::ECALL_unlinkat(RevInst& inst){
-  output->verbose(CALL_INFO, 2, 0,
+  auto& EcallState = Harts.at(HartToExecID)->GetEcallState();
+  if( EcallState.bytesRead == 0 ){
+    output->verbose(CALL_INFO, 2, 0,
+                    "ECALL: unlinkat called by thread %" PRIu32
+                    " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
+  }
+  auto dirfd = RegFile->GetX<int>(RevReg::a0);
+  auto path = RegFile->GetX<uint64_t>(RevReg::a1);
+  auto flags = RegFile->GetX<int>(RevReg::a2);
 
-                  "ECALL: unlinkat called by thread %" PRIu32
-                  " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
-  return EcallStatus::SUCCESS;
+  auto action = [&]{
+    if( vfs ){
+      RegFile->SetX(RevReg::a0, vfs->Unlink(dirfd, EcallState.string, flags));
+      return;
+    }
+    int rc = int(EcallHost([&]{
+      int r = unlinkat(dirfd, EcallState.string.c_str(), (flags & RevVFS::REMOVEDIR) ? AT_REMOVEDIR : 0);
+      return int64_t(r < 0 ? -errno : r);
+    }));
+    RegFile->SetX(RevReg::a0, rc);
+  };
+  return EcallLoadAndParseString(inst, path, action);
 }
 
 // 36, rev_symlinkat(const char  * oldname, int newdfd, const char  * newname)
@@ -593,9 +1113,7 @@ EcallStatus RevProc::ECALL_openat(RevInst& inst){
   }
   auto dirfd = RegFile->GetX<int>(RevReg::a0);
   auto pathname = RegFile->GetX<uint64_t>(RevReg::a1);
-
-  // commented out to remove warnings
-  // auto flags = RegFile->GetX<int>(RevReg::a2);
+  auto flags = RegFile->GetX<int>(RevReg::a2);
   auto mode = RegFile->GetX<int>(RevReg::a3);
 
   /*
@@ -608,12 +1126,22 @@ EcallStatus RevProc::ECALL_openat(RevInst& inst){
 
 
   auto action = [&]{
-    // Do the openat on the host
-    dirfd = open(std::filesystem::current_path().c_str(), mode);
-    int fd = openat(dirfd, EcallState.string.c_str(), mode);
+    if( vfs ){
+      int fd = vfs->Open(dirfd, EcallState.string, flags, mode_t(mode));
+      if( fd >= 0 )
+        Harts.at(HartToExecID)->Thread->AddFD(fd);
+      RegFile->SetX(RevReg::a0, fd);
+      return;
+    }
+
+    // Do the openat on the host, relative to the current directory
+    int fd = int(EcallHost([&]{
+      return int64_t(openat(AT_FDCWD, EcallState.string.c_str(), flags, mode_t(mode)));
+    }));
 
     // Add the file descriptor to this thread
-    Harts.at(HartToExecID)->Thread->AddFD(fd);
+    if( fd >= 0 )
+      Harts.at(HartToExecID)->Thread->AddFD(fd);
 
     // openat returns the file descriptor of the opened file
     Harts.at(HartToExecID)->RegFile->SetX(RevReg::a0, fd);
@@ -641,7 +1169,7 @@ EcallStatus RevProc::ECALL_close(RevInst& inst){
     return EcallStatus::SUCCESS;
   }
   // Close file on host
-  int rc = close(fd);
+  int rc = vfs && vfs->IsOpen(fd) ? vfs->Close(fd) : int(EcallHost([&]{ return int64_t(close(fd)); }));
 
   // Remove from Ctx's fildes
   ActiveThread->RemoveFD(fd);
@@ -681,6 +1209,37 @@ EcallStatus RevProc::ECALL_getdents64(RevInst& inst){
   output->verbose(CALL_INFO, 2, 0,
                   "ECALL: getdents64 called by thread %" PRIu32
                   " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
+  auto fd = RegFile->GetX<int>(RevReg::a0);
+  auto dirent = RegFile->GetX<uint64_t>(RevReg::a1);
+  auto count = RegFile->GetX<uint32_t>(RevReg::a2);
+
+  if( !Harts.at(HartToExecID)->Thread->FindFD(fd) ){
+    RegFile->SetX(RevReg::a0, -EBADF);
+    return EcallStatus::SUCCESS;
+  }
+
+  // struct linux_dirent64 has the same layout on every Linux target
+  std::vector<char> buf;
+  ssize_t rc;
+  if( vfs && vfs->IsOpen(fd) ){
+    rc = vfs->GetDents(fd, count, buf);
+  }else{
+    rc = EcallHost([&]{
+#ifdef SYS_getdents64
+      buf.resize(count);
+      long r = syscall(SYS_getdents64, fd, buf.data(), buf.size());
+      buf.resize(r > 0 ? size_t(r) : 0);
+      return int64_t(r < 0 ? -errno : r);
+#else
+      return int64_t(-ENOSYS);
+#endif
+    }, &buf);
+  }
+  if( rc > 0 ){
+    mem->WriteMem(HartToExecID, dirent, uint32_t(rc), buf.data());
+    ChargeEcallBytes(rc);
+  }
+  RegFile->SetX(RevReg::a0, rc);
   return EcallStatus::SUCCESS;
 }
 
@@ -689,10 +1248,41 @@ EcallStatus RevProc::ECALL_lseek(RevInst& inst){
   output->verbose(CALL_INFO, 2, 0,
                   "ECALL: lseek called by thread %" PRIu32
                   " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
+  auto fd = RegFile->GetX<int>(RevReg::a0);
+
+  // RV64 is lseek(fd, offset, whence); RV32 is llseek with the result in memory
+  off_t offset;
+  int whence;
+  if( feature->IsRV32() ){
+    offset = off_t(uint64_t(RegFile->GetX<uint32_t>(RevReg::a1)) << 32 | RegFile->GetX<uint32_t>(RevReg::a2));
+    whence = RegFile->GetX<int>(RevReg::a4);
+  }else{
+    offset = RegFile->GetX<int64_t>(RevReg::a1);
+    whence = RegFile->GetX<int>(RevReg::a2);
+  }
+
+  off_t rc;
+  if( !Harts.at(HartToExecID)->Thread->FindFD(fd) ){
+    rc = -EBADF;
+  }else if( vfs && vfs->IsOpen(fd) ){
+    rc = vfs->Seek(fd, offset, whence);
+  }else{
+    rc = EcallHost([&]{
+      off_t r = lseek(fd, offset, whence);
+      return int64_t(r < 0 ? -errno : r);
+    });
+  }
+
+  if( feature->IsRV32() && rc >= 0 ){
+    int64_t result = rc;
+    mem->WriteMem(HartToExecID, RegFile->GetX<uint32_t>(RevReg::a3), sizeof(result), &result);
+    rc = 0;
+  }
+  RegFile->SetX(RevReg::a0, rc);
   return EcallStatus::SUCCESS;
 }
 
-// 63, rev_read(unsigned int fd
+// 63, rev_read(unsigned int fd, char  *buf, size_t count)
 EcallStatus RevProc::ECALL_read(RevInst& inst){
   output->verbose(CALL_INFO, 2, 0,
                   "ECALL: read called by thread %" PRIu32
@@ -713,24 +1303,14 @@ EcallStatus RevProc::ECALL_read(RevInst& inst){
     return EcallStatus::SUCCESS;
   }
 
-  // This buffer is an intermediate buffer for storing the data read from host
-  // for later use in writing to RevMem
-  std::vector<char> TmpBuf(BufSize);
-
-  // Do the read on the host
-  int rc = read(fd, &TmpBuf[0], BufSize);
-
-  // Write that data to the buffer inside of Rev
-  mem->WriteMem(HartToExecID, BufAddr, BufSize, &TmpBuf[0]);
-
-  RegFile->SetX(RevReg::a0, rc);
+  RegFile->SetX(RevReg::a0, EcallReadInto(fd, BufAddr, BufSize, nullptr));
   return EcallStatus::SUCCESS;
 }
 
-
+// 64, rev_write(unsigned int fd, const char  *buf, size_t count)
 EcallStatus RevProc::ECALL_write(RevInst& inst){
   auto& EcallState = Harts.at(HartToExecID)->GetEcallState();
-  if( EcallState.bytesRead == 0 ){
+  if( EcallState.bytesRead == 0 && EcallState.string.empty() ){
     output->verbose(CALL_INFO, 2, 0,
                     "ECALL: write called by thread %" PRIu32
                     " on hart %" PRIu32 "\n",  ActiveThreadID, HartToExecID);
@@ -739,60 +1319,39 @@ EcallStatus RevProc::ECALL_write(RevInst& inst){
   auto addr = RegFile->GetX<uint64_t>(RevReg::a1);
   auto nbytes = RegFile->GetX<uint64_t>(RevReg::a2);
 
-  auto lsq_hash = LSQHash(RevReg::a0, RevRegClass::RegGPR, HartToExecID); // Cached hash value
-
-  if(EcallState.bytesRead && LSQueue->count(lsq_hash) == 0){
-    EcallState.string += std::string_view(EcallState.buf.data(), EcallState.bytesRead);
-    EcallState.bytesRead = 0;
-  }
-
-  auto nleft = nbytes - EcallState.string.size();
-  if(nleft == 0 && LSQueue->count(lsq_hash) == 0){
-    int rc = write(fd, EcallState.string.data(), EcallState.string.size());
+  // hand the guest pages straight to the host when they are addressable
+  std::vector<iovec> iov;
+  if( EcallState.string.empty() && EcallState.bytesRead == 0 &&
+      EcallHostIovecs(addr, nbytes, iov) ){
+    ssize_t rc = EcallHostIO(true, fd, iov, nullptr);
+    ChargeEcallBytes(rc > 0 ? rc : 0);
     RegFile->SetX(RevReg::a0, rc);
-    EcallState.clear();
-    DependencyClear(HartToExecID, RevReg::a0, false);
     return EcallStatus::SUCCESS;
   }
 
-  if (LSQueue->count(lsq_hash) == 0) {
-    MemReq req (addr + EcallState.string.size(), RevReg::a0, RevRegClass::RegGPR,
-                HartToExecID, MemOp::MemOpREAD, true, RegFile->GetMarkLoadComplete());
-    LSQueue->insert(req.LSQHashPair());
-
-    if(nleft >= 8){
-      mem->ReadVal(HartToExecID, addr+EcallState.string.size(),
-                   reinterpret_cast<uint64_t*>(EcallState.buf.data()),
-                   req, RevFlag::F_NONE);
-      EcallState.bytesRead = 8;
-    } else if(nleft >= 4){
-      mem->ReadVal(HartToExecID, addr+EcallState.string.size(),
-                   reinterpret_cast<uint32_t*>(EcallState.buf.data()),
-                   req, RevFlag::F_NONE);
-      EcallState.bytesRead = 4;
-    } else if(nleft >= 2){
-      mem->ReadVal(HartToExecID, addr+EcallState.string.size(),
-                   reinterpret_cast<uint16_t*>(EcallState.buf.data()),
-                   req, RevFlag::F_NONE);
-      EcallState.bytesRead = 2;
-    } else{
-      mem->ReadVal(HartToExecID, addr+EcallState.string.size(),
-                   reinterpret_cast<uint8_t*>(EcallState.buf.data()),
-                   req, RevFlag::F_NONE);
-      EcallState.bytesRead = 1;
-    }
-
-    DependencySet(HartToExecID, RevReg::a0, false);
-    return EcallStatus::CONTINUE;
-  }
-
-  return EcallStatus::CONTINUE;
+  return EcallLoadBuffer(addr, nbytes, [&]{
+    RegFile->SetX(RevReg::a0, EcallHostIO(true, fd, {{EcallState.string.data(), EcallState.string.size()}}, nullptr));
+  });
 }
+
 // 65, rev_readv(unsigned long fd, const struct iovec  *vec, unsigned long vlen)
 EcallStatus RevProc::ECALL_readv(RevInst& inst){
   output->verbose(CALL_INFO, 2, 0,
                   "ECALL: readv called by thread %" PRIu32
                   " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
+  auto fd = RegFile->GetX<int>(RevReg::a0);
+  auto vec = RegFile->GetX<uint64_t>(RevReg::a1);
+  auto vlen = RegFile->GetX<uint64_t>(RevReg::a2);
+
+  std::vector<iovec> iov;
+  std::vector<std::pair<uint64_t, uint64_t>> bufs;
+  ssize_t rc = EcallGuestIovecs(vec, vlen, iov, &bufs);
+  if( rc > 0 ){
+    rc = EcallHostIO(false, fd, iov, nullptr);
+    EcallRevokeFutures(bufs, rc);
+    ChargeEcallBytes(rc > 0 ? rc : 0);
+  }
+  RegFile->SetX(RevReg::a0, rc);
   return EcallStatus::SUCCESS;
 }
 
@@ -801,6 +1360,17 @@ EcallStatus RevProc::ECALL_writev(RevInst& inst){
   output->verbose(CALL_INFO, 2, 0,
                   "ECALL: writev called by thread %" PRIu32
                   " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
+  auto fd = RegFile->GetX<int>(RevReg::a0);
+  auto vec = RegFile->GetX<uint64_t>(RevReg::a1);
+  auto vlen = RegFile->GetX<uint64_t>(RevReg::a2);
+
+  std::vector<iovec> iov;
+  ssize_t rc = EcallGuestIovecs(vec, vlen, iov);
+  if( rc > 0 ){
+    rc = EcallHostIO(true, fd, iov, nullptr);
+    ChargeEcallBytes(rc > 0 ? rc : 0);
+  }
+  RegFile->SetX(RevReg::a0, rc);
   return EcallStatus::SUCCESS;
 }
 
@@ -809,15 +1379,40 @@ EcallStatus RevProc::ECALL_pread64(RevInst& inst){
   output->verbose(CALL_INFO, 2, 0,
                   "ECALL: pread64 called by thread %" PRIu32
                   " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
+  auto fd = RegFile->GetX<int>(RevReg::a0);
+  auto BufAddr = RegFile->GetX<uint64_t>(RevReg::a1);
+  auto BufSize = RegFile->GetX<uint64_t>(RevReg::a2);
+  off_t pos = EcallOffset(RevReg::a3, RevReg::a4);
+
+  RegFile->SetX(RevReg::a0, EcallReadInto(fd, BufAddr, BufSize, &pos));
   return EcallStatus::SUCCESS;
 }
 
 // 68, rev_pwrite64(unsigned int fd, const char  *buf, size_t count, loff_t pos)
 EcallStatus RevProc::ECALL_pwrite64(RevInst& inst){
-  output->verbose(CALL_INFO, 2, 0,
-                  "ECALL: pwrite64 called by thread %" PRIu32
-                  " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
-  return EcallStatus::SUCCESS;
+  auto& EcallState = Harts.at(HartToExecID)->GetEcallState();
+  if( EcallState.bytesRead == 0 && EcallState.string.empty() ){
+    output->verbose(CALL_INFO, 2, 0,
+                    "ECALL: pwrite64 called by thread %" PRIu32
+                    " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
+  }
+  auto fd = RegFile->GetX<int>(RevReg::a0);
+  auto addr = RegFile->GetX<uint64_t>(RevReg::a1);
+  auto nbytes = RegFile->GetX<uint64_t>(RevReg::a2);
+  off_t pos = EcallOffset(RevReg::a3, RevReg::a4);
+
+  std::vector<iovec> iov;
+  if( EcallState.string.empty() && EcallState.bytesRead == 0 &&
+      EcallHostIovecs(addr, nbytes, iov) ){
+    ssize_t rc = EcallHostIO(true, fd, iov, &pos);
+    ChargeEcallBytes(rc > 0 ? rc : 0);
+    RegFile->SetX(RevReg::a0, rc);
+    return EcallStatus::SUCCESS;
+  }
+
+  return EcallLoadBuffer(addr, nbytes, [&]{
+    RegFile->SetX(RevReg::a0, EcallHostIO(true, fd, {{EcallState.string.data(), EcallState.string.size()}}, &pos));
+  });
 }
 
 // 69, rev_preadv(unsigned long fd, const struct iovec  *vec, unsigned long vlen, unsigned long pos_l, unsigned long pos_h)
@@ -825,6 +1420,20 @@ EcallStatus RevProc::ECALL_preadv(RevInst& inst){
   output->verbose(CALL_INFO, 2, 0,
                   "ECALL: preadv called by thread %" PRIu32
                   " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
+  auto fd = RegFile->GetX<int>(RevReg::a0);
+  auto vec = RegFile->GetX<uint64_t>(RevReg::a1);
+  auto vlen = RegFile->GetX<uint64_t>(RevReg::a2);
+  off_t pos = EcallOffset(RevReg::a3, RevReg::a4);
+
+  std::vector<iovec> iov;
+  std::vector<std::pair<uint64_t, uint64_t>> bufs;
+  ssize_t rc = EcallGuestIovecs(vec, vlen, iov, &bufs);
+  if( rc > 0 ){
+    rc = EcallHostIO(false, fd, iov, &pos);
+    EcallRevokeFutures(bufs, rc);
+    ChargeEcallBytes(rc > 0 ? rc : 0);
+  }
+  RegFile->SetX(RevReg::a0, rc);
   return EcallStatus::SUCCESS;
 }
 
@@ -833,6 +1442,18 @@ EcallStatus RevProc::ECALL_pwritev(RevInst& inst){
   output->verbose(CALL_INFO, 2, 0,
                   "ECALL: pwritev called by thread %" PRIu32
                   " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
+  auto fd = RegFile->GetX<int>(RevReg::a0);
+  auto vec = RegFile->GetX<uint64_t>(RevReg::a1);
+  auto vlen = RegFile->GetX<uint64_t>(RevReg::a2);
+  off_t pos = EcallOffset(RevReg::a3, RevReg::a4);
+
+  std::vector<iovec> iov;
+  ssize_t rc = EcallGuestIovecs(vec, vlen, iov);
+  if( rc > 0 ){
+    rc = EcallHostIO(true, fd, iov, &pos);
+    ChargeEcallBytes(rc > 0 ? rc : 0);
+  }
+  RegFile->SetX(RevReg::a0, rc);
   return EcallStatus::SUCCESS;
 }
 
@@ -854,10 +1475,45 @@ EcallStatus RevProc::ECALL_pselect6_time32(RevInst& inst){
 
 // 73, rev_ppoll_time32(struct pollfd  *, unsigned int, struct old_timespec32  *, const sigset_t  *, size_t)
 EcallStatus RevProc::ECALL_ppoll_time32(RevInst& inst){
-  output->verbose(CALL_INFO, 2, 0,
-                  "ECALL: ppoll_time32 called by thread %" PRIu32
-                  " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
-  return EcallStatus::SUCCESS;
+  auto& EcallState = Harts.at(HartToExecID)->GetEcallState();
+  if( EcallState.bytesRead == 0 && EcallState.string.empty() ){
+    output->verbose(CALL_INFO, 2, 0,
+                    "ECALL: ppoll_time32 called by thread %" PRIu32
+                    " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
+  }
+  auto nfds = RegFile->GetX<uint64_t>(RevReg::a1);
+  auto tmo = RegFile->GetX<uint64_t>(RevReg::a2);
+
+  // Only ppoll without descriptors is modeled: RISC-V has no pause(), so
+  // this is how the C library pauses (no timeout) or sleeps (timeout)
+  if( nfds != 0 )
+    return EcallStatus::SUCCESS;
+
+  if( EcallState.bytesRead == 0 && EcallState.string.empty() &&
+      !HartHasNoDependencies(HartToExecID) )
+    return EcallStatus::CONTINUE;
+
+  if( tmo == 0 ){
+    // there are no signals to deliver, so the thread sleeps until the end
+    EcallSleep(UINT64_MAX);
+    return EcallStatus::SUCCESS;
+  }
+
+  if( timeConverter == nullptr ){
+    RegFile->SetX(RevReg::a0, -EINVAL);
+    return EcallStatus::SUCCESS;
+  }
+
+  return EcallLoadGuest(tmo, 16, [&](const char* ts){
+    uint64_t nanos;
+    if( !EcallTimespecToNanos(ts, nanos) ){
+      RegFile->SetX(RevReg::a0, -EINVAL);
+    }else if( uint64_t cycles = EcallNanosToCycles(nanos) ){
+      EcallSleep(cycles);
+    }else{
+      RegFile->SetX(RevReg::a0, 0);
+    }
+  });
 }
 
 // 74, rev_signalfd4(int ufd, sigset_t  *user_mask, size_t sizemask, int flags)
@@ -913,6 +1569,53 @@ EcallStatus RevProc::ECALL_newfstat(RevInst& inst){
   output->verbose(CALL_INFO, 2, 0,
                   "ECALL: newfstat called by thread %" PRIu32
                   " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
+  auto fd = RegFile->GetX<int>(RevReg::a0);
+  auto statbuf = RegFile->GetX<uint64_t>(RevReg::a1);
+
+  if( !Harts.at(HartToExecID)->Thread->FindFD(fd) ){
+    RegFile->SetX(RevReg::a0, -EBADF);
+    return EcallStatus::SUCCESS;
+  }
+
+  // files in the in-memory filesystem have no owner and no timestamps
+  std::vector<char> st(RevStat::SIZE);
+  auto put = [&](size_t off, auto val){ memcpy(&st[off], &val, sizeof(val)); };
+  if( vfs && vfs->IsOpen(fd) ){
+    RevVFS::Stat vst;
+    vfs->GetStat(fd, vst);
+    put(RevStat::INO,     uint64_t(vst.Ino));
+    put(RevStat::MODE,    uint32_t(vst.Mode));
+    put(RevStat::NLINK,   uint32_t(1));
+    put(RevStat::FSIZE,   int64_t(vst.Size));
+    put(RevStat::BLKSIZE, int32_t(4096));
+    put(RevStat::BLOCKS,  int64_t((vst.Size + 511) / 512));
+  }else{
+    int64_t rc = EcallHost([&]{
+      struct stat hst;
+      if( fstat(fd, &hst) < 0 )
+        return int64_t(-errno);
+      put(RevStat::DEV,     uint64_t(hst.st_dev));
+      put(RevStat::INO,     uint64_t(hst.st_ino));
+      put(RevStat::MODE,    uint32_t(hst.st_mode));
+      put(RevStat::NLINK,   uint32_t(hst.st_nlink));
+      put(RevStat::UID,     uint32_t(hst.st_uid));
+      put(RevStat::GID,     uint32_t(hst.st_gid));
+      put(RevStat::RDEV,    uint64_t(hst.st_rdev));
+      put(RevStat::FSIZE,   int64_t(hst.st_size));
+      put(RevStat::BLKSIZE, int32_t(hst.st_blksize));
+      put(RevStat::BLOCKS,  int64_t(hst.st_blocks));
+      put(RevStat::ATIME,   int64_t(hst.st_atime));
+      put(RevStat::MTIME,   int64_t(hst.st_mtime));
+      put(RevStat::CTIME,   int64_t(hst.st_ctime));
+      return int64_t(0);
+    }, &st);
+    if( rc < 0 || st.size() != RevStat::SIZE ){
+      RegFile->SetX(RevReg::a0, rc < 0 ? rc : -EIO);
+      return EcallStatus::SUCCESS;
+    }
+  }
+  mem->WriteMem(HartToExecID, statbuf, st.size(), st.data());
+  RegFile->SetX(RevReg::a0, 0);
   return EcallStatus::SUCCESS;
 }
 
@@ -1027,6 +1730,27 @@ EcallStatus RevProc::ECALL_exit(RevInst& inst){
                   " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
   auto status = RegFile->GetX<uint64_t>(RevReg::a0);
 
+  // A thread created by clone() (the only detached threads) only ends
+  // itself, as on Linux; the main thread and rev_pthread_create threads
+  // end the program
+  if( Harts.at(HartToExecID)->Thread->IsDetached() ){
+    if( !HartHasNoDependencies(HartToExecID) ){
+      return EcallStatus::CONTINUE;
+    }
+    output->verbose(CALL_INFO, 6, 0,
+                    "thread %" PRIu32 " on hart %" PRIu32 " exiting with"
+                    " status %" PRIu64 "\n",
+                    ActiveThreadID, HartToExecID, status );
+    std::unique_ptr<RevThread> ExitingThread = PopThreadFromHart(HartToExecID);
+    ExitingThread->SetState(ThreadState::DONE);
+    HartsClearToExecute[HartToExecID] = false;
+    HartsClearToDecode[HartToExecID] = false;
+    IdleHarts.set(HartToExecID);
+    ClearChildTID(*ExitingThread, HartToExecID);
+    AddThreadsThatChangedState(std::move(ExitingThread));
+    return EcallStatus::SUCCESS;
+  }
+
   output->verbose(CALL_INFO, 0, 0,
                   "thread %" PRIu32 " on hart %" PRIu32 "exiting with"
                   " status %" PRIu64 "\n",
@@ -1041,6 +1765,13 @@ EcallStatus RevProc::ECALL_exit_group(RevInst& inst){
   output->verbose(CALL_INFO, 2, 0,
                   "ECALL: exit_group called by thread %" PRIu32
                   " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
+  auto status = RegFile->GetX<uint64_t>(RevReg::a0);
+
+  output->verbose(CALL_INFO, 0, 0,
+                  "thread %" PRIu32 " on hart %" PRIu32 " exiting the"
+                  " program with status %" PRIu64 "\n",
+                  ActiveThreadID, HartToExecID, status );
+  exit(status);
   return EcallStatus::SUCCESS;
 }
 
@@ -1057,6 +1788,9 @@ EcallStatus RevProc::ECALL_set_tid_address(RevInst& inst){
   output->verbose(CALL_INFO, 2, 0,
                   "ECALL: set_tid_address called by thread %" PRIu32
                   " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
+  RevThread& Thread = *Harts.at(HartToExecID)->Thread;
+  Thread.SetClearChildTID(RegFile->GetX<uint64_t>(RevReg::a0));
+  RegFile->SetX(RevReg::a0, Thread.GetID());
   return EcallStatus::SUCCESS;
 }
 
@@ -1068,12 +1802,345 @@ EcallStatus RevProc::ECALL_unshare(RevInst& inst){
   return EcallStatus::SUCCESS;
 }
 
+// Guest (RISC-V Linux) futex operation encodings
+namespace RevFutex{
+  constexpr int WAIT          = 0;
+  constexpr int WAKE          = 1;
+  constexpr int REQUEUE       = 3;
+  constexpr int CMP_REQUEUE   = 4;
+  constexpr int WAKE_OP       = 5;
+  constexpr int WAIT_BITSET   = 9;
+  constexpr int WAKE_BITSET   = 10;
+  constexpr int CMD_MASK      = 0x7f;   // strips FUTEX_PRIVATE_FLAG and FUTEX_CLOCK_REALTIME
+  constexpr uint32_t BITSET_MATCH_ANY = 0xffffffff;
+}
+
+/// Read Len bytes of guest memory at Addr and call action() with them
+EcallStatus RevProc::EcallLoadGuest(uint64_t Addr, size_t Len, std::function<void(const char*)> action){
+  auto& EcallState = Harts.at(HartToExecID)->GetEcallState();
+  if( EcallState.string.empty() && EcallState.bytesRead == 0 ){
+    std::vector<char> data(Len);
+    if( EcallCopyFromGuest(Addr, data.data(), Len) ){
+      action(data.data());
+      return EcallStatus::SUCCESS;
+    }
+  }
+  return EcallLoadBuffer(Addr, Len, [&]{ action(EcallState.string.data()); });
+}
+
+/// Convert a duration in nanoseconds to cycles, rounding up so that a
+/// thread never sleeps for less than it asked for
+uint64_t RevProc::EcallNanosToCycles(uint64_t Nanos) const {
+  // core time is kept in picoseconds (see clock_gettime)
+  if( Nanos >= (UINT64_MAX - 1) / 1000 )
+    return UINT64_MAX - 1;
+  SimTime_t factor = timeConverter->getFactor();
+  return (Nanos * 1000 + factor - 1) / factor;
+}
+
+/// The time reported to the guest by clock_gettime, in nanoseconds
+uint64_t RevProc::EcallNowNanos() const {
+  return timeConverter->convertToCoreTime(Stats.totalCycles) / 1000;
+}
+
+/// Deschedule the active thread onto the wait queue of the futex at Addr.
+/// The thread resumes after the ECALL with a0 = 0 once it has been woken,
+/// or with a0 = -ETIMEDOUT once Timeout cycles have passed.
+void RevProc::FutexBlock(uint64_t Addr, uint32_t Bitset, uint64_t Timeout){
+  RegFile->SetX(RevReg::a0, 0);
+
+  std::unique_ptr<RevThread> BlockedThread = PopThreadFromHart(HartToExecID);
+  BlockedThread->SetState(ThreadState::BLOCKED);
+  BlockedThread->SetFutexWait(Addr, Bitset);
+  if( Timeout != UINT64_MAX ){
+    BlockedThread->SetSleep(Timeout);
+  }
+
+  // Signal to RevCPU this thread is has changed state
+  AddThreadsThatChangedState(std::move(BlockedThread));
+}
+
+/// Deschedule the active thread for Cycles cycles.  The thread resumes
+/// after the ECALL with a0 = 0.
+void RevProc::EcallSleep(uint64_t Cycles){
+  RegFile->SetX(RevReg::a0, 0);
+
+  std::unique_ptr<RevThread> SleepingThread = PopThreadFromHart(HartToExecID);
+  SleepingThread->SetState(ThreadState::BLOCKED);
+  SleepingThread->SetSleep(Cycles);
+
+  // Signal to RevCPU this thread is has changed state
+  AddThreadsThatChangedState(std::move(SleepingThread));
+}
+
+// Guest (RISC-V Linux) clone flags
+namespace RevClone{
+  constexpr uint64_t VM             = 0x00000100;
+  constexpr uint64_t FS             = 0x00000200;
+  constexpr uint64_t FILES          = 0x00000400;
+  constexpr uint64_t SIGHAND        = 0x00000800;
+  constexpr uint64_t THREAD         = 0x00010000;
+  constexpr uint64_t SYSVSEM        = 0x00040000;
+  constexpr uint64_t SETTLS         = 0x00080000;
+  constexpr uint64_t PARENT_SETTID  = 0x00100000;
+  constexpr uint64_t CHILD_CLEARTID = 0x00200000;
+  constexpr uint64_t DETACHED       = 0x00400000;
+  constexpr uint64_t CHILD_SETTID   = 0x01000000;
+  constexpr uint64_t SIGNAL_MASK    = 0xff;         // exit signal, unused for threads
+
+  // Flags that only describe what a thread shares with its creator
+  constexpr uint64_t SUPPORTED = VM | FS | FILES | SIGHAND | THREAD | SYSVSEM | SETTLS |
+                                 PARENT_SETTID | CHILD_CLEARTID | DETACHED | CHILD_SETTID |
+                                 SIGNAL_MASK;
+}
+
+/// Create a thread that shares the address space of the active thread, as
+/// glibc and musl pthread_create do through clone/clone3.  The child resumes
+/// after the ECALL with a copy of the caller's registers, a0 = 0 and the
+/// stack and thread pointer it was given.  There is no process model, so a
+/// clone without CLONE_VM | CLONE_THREAD (fork) fails with -ENOSYS.
+EcallStatus RevProc::EcallClone(uint64_t Flags, uint64_t NewSP, uint64_t ParentTID,
+                                uint64_t TLS, uint64_t ChildTID){
+  if( (Flags & ~RevClone::SUPPORTED) ||
+      ((Flags & RevClone::THREAD) && !(Flags & RevClone::SIGHAND)) ||
+      ((Flags & RevClone::SIGHAND) && !(Flags & RevClone::VM)) ){
+    RegFile->SetX(RevReg::a0, -EINVAL);
+    return EcallStatus::SUCCESS;
+  }
+  if( (Flags & (RevClone::VM | RevClone::THREAD)) != (RevClone::VM | RevClone::THREAD) ){
+    RegFile->SetX(RevReg::a0, -ENOSYS);
+    return EcallStatus::SUCCESS;
+  }
+
+  // The child starts from the caller's registers, so wait for its loads
+  if( !HartHasNoDependencies(HartToExecID) ){
+    return EcallStatus::CONTINUE;
+  }
+
+  // Thread IDs are pid_t to the guest: keep them positive so the
+  // parent's return value is not mistaken for an errno
+  uint32_t NewTID;
+  do{
+    NewTID = GetNewThreadID();
+  }while( NewTID == 0 || NewTID == _INVALID_TID_ || NewTID > uint32_t(INT32_MAX) );
+
+  auto ChildRegFile = std::make_unique<RevRegFile>(*RegFile);
+  // the PC is already past the ECALL; the hart it lands on supplies the LSQ
+  ChildRegFile->SetLSQ(nullptr);
+  ChildRegFile->SetTrigger(false);
+  ChildRegFile->SetCost(0);
+  ChildRegFile->SetSCAUSE(uint64_t(EcallStatus::SUCCESS));
+  ChildRegFile->SetX(RevReg::a0, 0);
+  if( NewSP ){
+    ChildRegFile->SetX(RevReg::sp, NewSP);
+  }
+  if( Flags & RevClone::SETTLS ){
+    ChildRegFile->SetX(RevReg::tp, TLS);
+  }
+
+  // The stack and TLS belong to the guest, which frees them itself
+  std::shared_ptr<RevMem::MemSegment> NoThreadMem;
+  RevThread& Parent = *Harts.at(HartToExecID)->Thread;
+  auto Child = std::make_unique<RevThread>(NewTID, Parent.GetID(), NoThreadMem,
+                                           std::move(ChildRegFile));
+  Child->SetAffinity(Parent.GetAffinity());
+  Child->SetDetached(true);
+  if( Flags & RevClone::CHILD_CLEARTID ){
+    Child->SetClearChildTID(ChildTID);
+  }
+  if( Flags & RevClone::FILES ){
+    // the descriptors stay open until the creator closes them
+    for( int fd : Parent.GetFildes() ){
+      Child->AddFD(fd);
+    }
+    Child->SetCloseFDs(false);
+  }
+  if( replay && replay->IsReplaying() ){
+    Child->SetCloseFDs(false);
+  }
+  Parent.AddChildID(NewTID);
+
+  // Both tids are written before either thread can run
+  if( Flags & RevClone::PARENT_SETTID ){
+    mem->WriteMem(HartToExecID, ParentTID, sizeof(NewTID), &NewTID);
+  }
+  if( Flags & RevClone::CHILD_SETTID ){
+    mem->WriteMem(HartToExecID, ChildTID, sizeof(NewTID), &NewTID);
+  }
+
+  output->verbose(CALL_INFO, 6, 0,
+                  "Thread %" PRIu32 " cloned thread %" PRIu32 " (flags 0x%" PRIx64 ")\n",
+                  Parent.GetID(), NewTID, Flags);
+  AddThreadsThatChangedState(std::move(Child));
+  RegFile->SetX(RevReg::a0, NewTID);
+  return EcallStatus::SUCCESS;
+}
+
+/// Clear the child tid of an exiting thread and wake one waiter on it, which
+/// is how pthread_join learns that a clone()d thread is gone
+void RevProc::ClearChildTID(const RevThread& Thread, unsigned HartID){
+  if( uint64_t Addr = Thread.GetClearChildTID() ){
+    uint32_t Zero = 0;
+    mem->WriteMem(HartID, Addr, sizeof(Zero), &Zero);
+    FutexWake(Addr, 1, RevFutex::BITSET_MATCH_ANY, 0, 0);
+  }
+}
+
 // 98, rev_futex(u32  *uaddr, int op, u32 val, struct __kernel_timespec  *utime, u32  *uaddr2, u32 val3)
 EcallStatus RevProc::ECALL_futex(RevInst& inst){
-  output->verbose(CALL_INFO, 2, 0,
-                  "ECALL: futex called by thread %" PRIu32
-                  " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
-  return EcallStatus::SUCCESS;
+  auto& EcallState = Harts.at(HartToExecID)->GetEcallState();
+  if( EcallState.bytesRead == 0 && EcallState.string.empty() ){
+    output->verbose(CALL_INFO, 2, 0,
+                    "ECALL: futex called by thread %" PRIu32
+                    " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
+  }
+  auto uaddr  = RegFile->GetX<uint64_t>(RevReg::a0);
+  auto op     = RegFile->GetX<int>(RevReg::a1) & RevFutex::CMD_MASK;
+  auto val    = RegFile->GetX<uint32_t>(RevReg::a2);
+  auto val2   = RegFile->GetX<uint64_t>(RevReg::a3);   // utime doubles as a count for REQUEUE and WAKE_OP
+  auto uaddr2 = RegFile->GetX<uint64_t>(RevReg::a4);
+  auto val3   = RegFile->GetX<uint32_t>(RevReg::a5);
+
+  if( uaddr % sizeof(uint32_t) ){
+    RegFile->SetX(RevReg::a0, -EINVAL);
+    return EcallStatus::SUCCESS;
+  }
+
+  switch( op ){
+  case RevFutex::WAIT:
+  case RevFutex::WAIT_BITSET: {
+    uint32_t bitset = op == RevFutex::WAIT ? RevFutex::BITSET_MATCH_ANY : val3;
+    if( !bitset ){
+      RegFile->SetX(RevReg::a0, -EINVAL);
+      return EcallStatus::SUCCESS;
+    }
+    // the thread can only leave the hart once its outstanding loads land
+    if( EcallState.bytesRead == 0 && EcallState.string.empty() &&
+        !HartHasNoDependencies(HartToExecID) ){
+      return EcallStatus::CONTINUE;
+    }
+
+    // The timeout is relative for FUTEX_WAIT and absolute for
+    // FUTEX_WAIT_BITSET.  It is only honored when it can be read without
+    // going through the memory hierarchy.
+    uint64_t timeout = UINT64_MAX;
+    char ts[16];
+    if( val2 && EcallState.string.empty() && EcallState.bytesRead == 0 &&
+        timeConverter && EcallCopyFromGuest(val2, ts, sizeof(ts)) ){
+      uint64_t nanos;
+      if( !EcallTimespecToNanos(ts, nanos) ){
+        RegFile->SetX(RevReg::a0, -EINVAL);
+        return EcallStatus::SUCCESS;
+      }
+      if( op == RevFutex::WAIT_BITSET ){
+        uint64_t now = EcallNowNanos();
+        nanos = nanos > now ? nanos - now : 0;
+      }
+      timeout = EcallNanosToCycles(nanos);
+    }
+
+    return EcallLoadGuest(uaddr, sizeof(uint32_t), [&](const char* data){
+      uint32_t word;
+      memcpy(&word, data, sizeof(word));
+      if( word != val ){
+        RegFile->SetX(RevReg::a0, -EAGAIN);
+      }else if( timeout == 0 ){
+        RegFile->SetX(RevReg::a0, -ETIMEDOUT);
+      }else{
+        FutexBlock(uaddr, bitset, timeout);
+      }
+    });
+  }
+
+  case RevFutex::WAKE:
+  case RevFutex::WAKE_BITSET: {
+    uint32_t bitset = op == RevFutex::WAKE ? RevFutex::BITSET_MATCH_ANY : val3;
+    if( !bitset ){
+      RegFile->SetX(RevReg::a0, -EINVAL);
+      return EcallStatus::SUCCESS;
+    }
+    RegFile->SetX(RevReg::a0, FutexWake(uaddr, val, bitset, 0, 0));
+    return EcallStatus::SUCCESS;
+  }
+
+  case RevFutex::REQUEUE:
+    RegFile->SetX(RevReg::a0, FutexWake(uaddr, val, RevFutex::BITSET_MATCH_ANY, uaddr2, val2));
+    return EcallStatus::SUCCESS;
+
+  case RevFutex::CMP_REQUEUE:
+    return EcallLoadGuest(uaddr, sizeof(uint32_t), [&](const char* data){
+      uint32_t word;
+      memcpy(&word, data, sizeof(word));
+      if( word != val3 ){
+        RegFile->SetX(RevReg::a0, -EAGAIN);
+      }else{
+        RegFile->SetX(RevReg::a0, FutexWake(uaddr, val, RevFutex::BITSET_MATCH_ANY, uaddr2, val2));
+      }
+    });
+
+  case RevFutex::WAKE_OP: {
+    // The read-modify-write of *uaddr2 must be atomic with respect to the
+    // other harts, so it is performed directly on guest memory
+    uint32_t oldval;
+    if( !EcallCopyFromGuest(uaddr2, &oldval, sizeof(oldval)) ){
+      RegFile->SetX(RevReg::a0, -ENOSYS);
+      return EcallStatus::SUCCESS;
+    }
+
+    // val3 = [op:4][cmp:4][oparg:12][cmparg:12]; both arguments are signed
+    unsigned wop    = (val3 >> 28) & 0xf;
+    unsigned cmp    = (val3 >> 24) & 0xf;
+    int32_t  oparg  = int32_t(val3 << 8) >> 20;
+    int32_t  cmparg = int32_t(val3 << 20) >> 20;
+    if( wop & 8 ){
+      if( oparg < 0 || oparg > 31 ){
+        RegFile->SetX(RevReg::a0, -EINVAL);
+        return EcallStatus::SUCCESS;
+      }
+      oparg = int32_t(1u << oparg);
+      wop &= 7;
+    }
+
+    uint32_t newval;
+    switch( wop ){
+    case 0: newval = uint32_t(oparg);            break;   // FUTEX_OP_SET
+    case 1: newval = oldval + uint32_t(oparg);   break;   // FUTEX_OP_ADD
+    case 2: newval = oldval | uint32_t(oparg);   break;   // FUTEX_OP_OR
+    case 3: newval = oldval & ~uint32_t(oparg);  break;   // FUTEX_OP_ANDN
+    case 4: newval = oldval ^ uint32_t(oparg);   break;   // FUTEX_OP_XOR
+    default:
+      RegFile->SetX(RevReg::a0, -ENOSYS);
+      return EcallStatus::SUCCESS;
+    }
+
+    bool cond;
+    switch( cmp ){
+    case 0: cond = int32_t(oldval) == cmparg; break;    // FUTEX_OP_CMP_EQ
+    case 1: cond = int32_t(oldval) != cmparg; break;    // FUTEX_OP_CMP_NE
+    case 2: cond = int32_t(oldval) <  cmparg; break;    // FUTEX_OP_CMP_LT
+    case 3: cond = int32_t(oldval) <= cmparg; break;    // FUTEX_OP_CMP_LE
+    case 4: cond = int32_t(oldval) >  cmparg; break;    // FUTEX_OP_CMP_GT
+    case 5: cond = int32_t(oldval) >= cmparg; break;    // FUTEX_OP_CMP_GE
+    default:
+      RegFile->SetX(RevReg::a0, -ENOSYS);
+      return EcallStatus::SUCCESS;
+    }
+
+    mem->WriteMem(HartToExecID, uaddr2, sizeof(newval), &newval);
+    uint64_t woken = FutexWake(uaddr, val, RevFutex::BITSET_MATCH_ANY, 0, 0);
+    if( cond ){
+      woken += FutexWake(uaddr2, val2, RevFutex::BITSET_MATCH_ANY, 0, 0);
+    }
+    RegFile->SetX(RevReg::a0, woken);
+    return EcallStatus::SUCCESS;
+  }
+
+  default:
+    output->verbose(CALL_INFO, 2, 0,
+                    "ECALL: futex operation %" PRIi32 " is not supported\n", op);
+    RegFile->SetX(RevReg::a0, -ENOSYS);
+    return EcallStatus::SUCCESS;
+  }
 }
 
 // 99, rev_set_robust_list(struct robust_list_head  *head, size_t len)
@@ -1094,10 +2161,32 @@ EcallStatus RevProc::ECALL_get_robust_list(RevInst& inst){
 
 // 101, rev_nanosleep(struct __kernel_timespec  *rqtp, struct __kernel_timespec  *rmtp)
 EcallStatus RevProc::ECALL_nanosleep(RevInst& inst){
-  output->verbose(CALL_INFO, 2, 0,
-                  "ECALL: nanosleep called by thread %" PRIu32
-                  " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
-  return EcallStatus::SUCCESS;
+  auto& EcallState = Harts.at(HartToExecID)->GetEcallState();
+  if( EcallState.bytesRead == 0 && EcallState.string.empty() ){
+    output->verbose(CALL_INFO, 2, 0,
+                    "ECALL: nanosleep called by thread %" PRIu32
+                    " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
+    // the thread can only leave the hart once its outstanding loads land
+    if( !HartHasNoDependencies(HartToExecID) )
+      return EcallStatus::CONTINUE;
+  }
+  auto rqtp = RegFile->GetX<uint64_t>(RevReg::a0);
+
+  if( timeConverter == nullptr ){
+    RegFile->SetX(RevReg::a0, -EINVAL);
+    return EcallStatus::SUCCESS;
+  }
+
+  return EcallLoadGuest(rqtp, 16, [&](const char* ts){
+    uint64_t nanos;
+    if( !EcallTimespecToNanos(ts, nanos) ){
+      RegFile->SetX(RevReg::a0, -EINVAL);
+    }else if( uint64_t cycles = EcallNanosToCycles(nanos) ){
+      EcallSleep(cycles);
+    }else{
+      RegFile->SetX(RevReg::a0, 0);
+    }
+  });
 }
 
 // 102, rev_getitimer(int which, struct __kernel_old_itimerval  *value)
@@ -1218,10 +2307,40 @@ EcallStatus RevProc::ECALL_clock_getres(RevInst& inst){
 
 // 115, rev_clock_nanosleep(clockid_t which_clock, int flags, const struct __kernel_timespec  *rqtp, struct __kernel_timespec  *rmtp)
 EcallStatus RevProc::ECALL_clock_nanosleep(RevInst& inst){
-  output->verbose(CALL_INFO, 2, 0,
-                  "ECALL: clock_nanosleep called by thread %" PRIu32
-                  " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
-  return EcallStatus::SUCCESS;
+  auto& EcallState = Harts.at(HartToExecID)->GetEcallState();
+  if( EcallState.bytesRead == 0 && EcallState.string.empty() ){
+    output->verbose(CALL_INFO, 2, 0,
+                    "ECALL: clock_nanosleep called by thread %" PRIu32
+                    " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
+    if( !HartHasNoDependencies(HartToExecID) )
+      return EcallStatus::CONTINUE;
+  }
+  constexpr int TIMER_ABSTIME_FLAG = 1;
+  auto flags = RegFile->GetX<int>(RevReg::a1);
+  auto rqtp = RegFile->GetX<uint64_t>(RevReg::a2);
+
+  // the C library turns the raw -errno into clock_nanosleep's positive error
+  if( timeConverter == nullptr ){
+    RegFile->SetX(RevReg::a0, -EINVAL);
+    return EcallStatus::SUCCESS;
+  }
+
+  return EcallLoadGuest(rqtp, 16, [&](const char* ts){
+    uint64_t nanos;
+    if( !EcallTimespecToNanos(ts, nanos) ){
+      RegFile->SetX(RevReg::a0, -EINVAL);
+      return;
+    }
+    if( flags & TIMER_ABSTIME_FLAG ){
+      uint64_t now = EcallNowNanos();
+      nanos = nanos > now ? nanos - now : 0;
+    }
+    if( uint64_t cycles = EcallNanosToCycles(nanos) ){
+      EcallSleep(cycles);
+    }else{
+      RegFile->SetX(RevReg::a0, 0);
+    }
+  });
 }
 
 // 116, rev_syslog(int type, char  *buf, int len)
@@ -1273,11 +2392,54 @@ EcallStatus RevProc::ECALL_sched_getparam(RevInst& inst){
 }
 
 // 122, rev_sched_setaffinity(pid_t pid, unsigned int len, unsigned long  *user_mask_ptr)
+// CPU N of the mask is hart N % numHarts of core N / numHarts.  Only the
+// calling thread (pid 0 or its own TID) can be changed; the other threads
+// are not reachable from this core.
 EcallStatus RevProc::ECALL_sched_setaffinity(RevInst& inst){
-  output->verbose(CALL_INFO, 2, 0,
-                  "ECALL: sched_setaffinity called by thread %" PRIu32
-                  " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
-  return EcallStatus::SUCCESS;
+  auto& EcallState = Harts.at(HartToExecID)->GetEcallState();
+  if( EcallState.bytesRead == 0 && EcallState.string.empty() ){
+    output->verbose(CALL_INFO, 2, 0,
+                    "ECALL: sched_setaffinity called by thread %" PRIu32
+                    " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
+  }
+  auto pid  = RegFile->GetX<int>(RevReg::a0);
+  auto len  = RegFile->GetX<uint32_t>(RevReg::a1);
+  auto mask = RegFile->GetX<uint64_t>(RevReg::a2);
+
+  RevThread* Thread = Harts.at(HartToExecID)->Thread.get();
+  if( pid != 0 && uint32_t(pid) != Thread->GetID() ){
+    RegFile->SetX(RevReg::a0, -ESRCH);
+    return EcallStatus::SUCCESS;
+  }
+  if( len == 0 ){
+    RegFile->SetX(RevReg::a0, -EINVAL);
+    return EcallStatus::SUCCESS;
+  }
+
+  // moving off a hart the new mask excludes needs a quiet hart
+  if( !HartHasNoDependencies(HartToExecID) )
+    return EcallStatus::CONTINUE;
+
+  const unsigned NumCPUs = opts->GetNumCores() * numHarts;
+  const size_t Bytes = std::min<size_t>(len, (NumCPUs + 7) / 8);
+  return EcallLoadGuest(mask, Bytes, [&](const char* data){
+    // bits beyond the last CPU are ignored, as the kernel does
+    std::vector<uint64_t> Affinity((NumCPUs + 63) / 64);
+    memcpy(Affinity.data(), data, Bytes);
+    if( NumCPUs % 64 )
+      Affinity.back() &= ~(~uint64_t{0} << (NumCPUs % 64));
+    if( std::none_of(Affinity.begin(), Affinity.end(), [](uint64_t w){ return w != 0; }) ){
+      RegFile->SetX(RevReg::a0, -EINVAL);
+      return;
+    }
+
+    Thread->SetAffinity(std::move(Affinity));
+    RegFile->SetX(RevReg::a0, 0);
+    if( !Thread->CanRunOn(GetCPU(HartToExecID)) ){
+      // give up this hart so the scheduler can move the thread
+      EcallSleep(0);
+    }
+  });
 }
 
 // 123, rev_sched_getaffinity(pid_t pid, unsigned int len, unsigned long  *user_mask_ptr)
@@ -1285,6 +2447,32 @@ EcallStatus RevProc::ECALL_sched_getaffinity(RevInst& inst){
   output->verbose(CALL_INFO, 2, 0,
                   "ECALL: sched_getaffinity called by thread %" PRIu32
                   " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
+  auto pid  = RegFile->GetX<int>(RevReg::a0);
+  auto len  = RegFile->GetX<uint32_t>(RevReg::a1);
+  auto mask = RegFile->GetX<uint64_t>(RevReg::a2);
+
+  const RevThread* Thread = Harts.at(HartToExecID)->Thread.get();
+  if( pid != 0 && uint32_t(pid) != Thread->GetID() ){
+    RegFile->SetX(RevReg::a0, -ESRCH);
+    return EcallStatus::SUCCESS;
+  }
+
+  // the kernel copies out whole longs covering every CPU
+  const unsigned NumCPUs = opts->GetNumCores() * numHarts;
+  const size_t LongBits = feature->IsRV32() ? 32 : 64;
+  const size_t Bytes = (NumCPUs + LongBits - 1) / LongBits * (LongBits / 8);
+  if( len < Bytes || len % (LongBits / 8) ){
+    RegFile->SetX(RevReg::a0, -EINVAL);
+    return EcallStatus::SUCCESS;
+  }
+
+  std::vector<uint8_t> Buf(Bytes);
+  for( unsigned cpu = 0; cpu < NumCPUs; cpu++ ){
+    if( Thread->CanRunOn(cpu) )
+      Buf[cpu / 8] |= uint8_t(1 << (cpu % 8));
+  }
+  mem->WriteMem(HartToExecID, mask, Bytes, Buf.data());
+  RegFile->SetX(RevReg::a0, Bytes);
   return EcallStatus::SUCCESS;
 }
 
@@ -1293,6 +2481,11 @@ EcallStatus RevProc::ECALL_sched_yield(RevInst& inst){
   output->verbose(CALL_INFO, 2, 0,
                   "ECALL: sched_yield called by thread %" PRIu32
                   " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
+  if( !HartHasNoDependencies(HartToExecID) )
+    return EcallStatus::CONTINUE;
+
+  // hand the hart to the next ready thread
+  EcallSleep(0);
   return EcallStatus::SUCCESS;
 }
 
@@ -1637,6 +2830,17 @@ EcallStatus RevProc::ECALL_getcpu(RevInst& inst){
   output->verbose(CALL_INFO, 2, 0,
                   "ECALL: getcpu called by thread %" PRIu32
                   " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
+  auto cpu  = RegFile->GetX<uint64_t>(RevReg::a0);
+  auto node = RegFile->GetX<uint64_t>(RevReg::a1);
+
+  // the CPU is the CPU-wide hart ID; every core is on node 0
+  uint32_t val = GetCPU(HartToExecID);
+  if( cpu )
+    mem->WriteMem(HartToExecID, cpu, sizeof(val), &val);
+  val = 0;
+  if( node )
+    mem->WriteMem(HartToExecID, node, sizeof(val), &val);
+  RegFile->SetX(RevReg::a0, 0);
   return EcallStatus::SUCCESS;
 }
 
@@ -1645,6 +2849,27 @@ EcallStatus RevProc::ECALL_gettimeofday(RevInst& inst){
   output->verbose(CALL_INFO, 2, 0,
                   "ECALL: gettimeofday called by thread %" PRIu32
                   " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
+  auto tv = RegFile->GetX<uint64_t>(RevReg::a0);
+  auto tz = RegFile->GetX<uint64_t>(RevReg::a1);
+
+  // like clock_gettime, the time of day is simulated time, not host time
+  if( tv ){
+    uint64_t now = timeConverter ? EcallNowNanos() : 0;
+    int64_t sec = int64_t(now / 1000000000ull);
+    int64_t usec = int64_t((now / 1000) % 1000000);
+    if( feature->IsRV32() ){
+      int32_t val[2] = { int32_t(sec), int32_t(usec) };
+      mem->WriteMem(HartToExecID, tv, sizeof(val), val);
+    }else{
+      int64_t val[2] = { sec, usec };
+      mem->WriteMem(HartToExecID, tv, sizeof(val), val);
+    }
+  }
+  if( tz ){
+    int32_t zone[2] = { 0, 0 };
+    mem->WriteMem(HartToExecID, tz, sizeof(zone), zone);
+  }
+  RegFile->SetX(RevReg::a0, 0);
   return EcallStatus::SUCCESS;
 }
 
@@ -2075,151 +3300,12 @@ EcallStatus RevProc::ECALL_clone(RevInst& inst){
   output->verbose(CALL_INFO, 2, 0,
                   "ECALL: clone called by thread %" PRIu32
                   " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
-  auto rtval = EcallStatus::SUCCESS;
- //  auto CloneArgsAddr = RegFile->GetX<uint64_t>(RevReg::a0);
- //  // auto SizeOfCloneArgs = RegFile()->GetX<size_t>(RevReg::a1);
-
- // if(0 == ECALL.bytesRead){
- //    // First time through the function...
- //    /* Fetch the clone_args */
- //    // struct clone_args args;  // So while clone_args is a whole struct, we appear to be only
- //                                // using the 1st uint64, so that's all we're going to fetch
- //   uint64_t* args = reinterpret_cast<uint64_t*>(ECALL.buf.data());
- //   mem->ReadVal<uint64_t>(HartToExecID, CloneArgsAddr, args, inst.hazard, RevFlag::F_NONE);
- //   ECALL.bytesRead = sizeof(*args);
- //   rtval = EcallStatus::CONTINUE;
- // }else{
- //    /*
- //    * Parse clone flags
- //    * NOTE: if no flags are set, we get fork() like behavior
- //    */
- //   uint64_t* args = reinterpret_cast<uint64_t*>(ECALL.buf.data());
- //    for( uint64_t bit=1; bit != 0; bit <<= 1 ){
- //      switch (*args & bit) {
- //        case CLONE_VM:
- //          // std::cout << "CLONE_VM is true" << std::endl;
- //          break;
- //        case CLONE_FS: /* Set if fs info shared between processes */
- //          // std::cout << "CLONE_FS is true" << std::endl;
- //          break;
- //        case CLONE_FILES: /* Set if open files shared between processes */
- //          // std::cout << "CLONE_FILES is true" << std::endl;
- //          break;
- //        case CLONE_SIGHAND: /* Set if signal handlers shared */
- //          // std::cout << "CLONE_SIGHAND is true" << std::endl;
- //          break;
- //        case CLONE_PIDFD: /* Set if a pidfd should be placed in the parent */
- //          // std::cout << "CLONE_PIDFD is true" << std::endl;
- //          break;
- //        case CLONE_PTRACE: /* Set if tracing continues on the child */
- //          // std::cout << "CLONE_PTRACE is true" << std::endl;
- //          break;
- //        case CLONE_VFORK: /* Set if the parent wants the child to wake it up on mm_release */
- //          // std::cout << "CLONE_VFORK is true" << std::endl;
- //          break;
- //        case CLONE_PARENT: /* Set if we want to have the same parent as the cloner */
- //          // std::cout << "CLONE_PARENT is true" << std::endl;
- //          break;
- //        case CLONE_THREAD: /* Set to add to same thread group */
- //          // std::cout << "CLONE_THREAD is true" << std::endl;
- //          break;
- //        case CLONE_NEWNS: /* Set to create new namespace */
- //          // std::cout << "CLONE_NEWNS is true" << std::endl;
- //          break;
- //        case CLONE_SYSVSEM: /* Set to shared SVID SEM_UNDO semantics */
- //          // std::cout << "CLONE_SYSVSEM is true" << std::endl;
- //          break;
- //        case CLONE_SETTLS: /* Set TLS info */
- //          // std::cout << "CLONE_SETTLS is true" << std::endl;
- //          break;
- //        case CLONE_PARENT_SETTID: /* Store TID in userlevel buffer before MM copy */
- //          // std::cout << "CLONE_PARENT_SETTID is true" << std::endl;
- //          break;
- //        case CLONE_CHILD_CLEARTID: /* Register exit futex and memory location to clear */
- //          // std::cout << "CLONE_CHILD_CLEARTID is true" << std::endl;
- //          break;
- //        case CLONE_DETACHED: /* Create clone detached */
- //          // std::cout << "CLONE_DETACHED is true" << std::endl;
- //          break;
- //        case CLONE_UNTRACED: /* Set if the tracing process can't force CLONE_PTRACE on this clone */
- //          // std::cout << "CLONE_UNTRACED is true" << std::endl;
- //          break;
- //        case CLONE_CHILD_SETTID: /* New cgroup namespace */
- //          // std::cout << "CLONE_CHILD_SETTID is true" << std::endl;
- //          break;
- //        case CLONE_NEWCGROUP: /* New cgroup namespace */
- //          // std::cout << "CLONE_NEWCGROUP is true" << std::endl;
- //          break;
- //        case CLONE_NEWUTS: /* New utsname group */
- //          // std::cout << "CLONE_NEWUTS is true" << std::endl;
- //          break;
- //        case CLONE_NEWIPC: /* New ipcs */
- //          // std::cout << "CLONE_NEWIPC is true" << std::endl;
- //          break;
- //        case CLONE_NEWUSER: /* New user namespace */
- //          // std::cout << "CLONE_NEWUSER is true" << std::endl;
- //          break;
- //        case CLONE_NEWPID: /* New pid namespace */
- //          // std::cout << "CLONE_NEWPID is true" << std::endl;
- //          break;
- //        case CLONE_NEWNET: /* New network namespace */
- //          // std::cout << "CLONE_NEWNET is true" << std::endl;
- //          break;
- //        case CLONE_IO: /* Clone I/O Context */
- //          // std::cout << "CLONE_IO is true" << std::endl;
- //          break;
- //        default:
- //          break;
- //      } // switch
- //    } // for
-
- //    /* Get the parent ctx (Current active, executing PID) */
- //    std::shared_ptr<RevThread> ParentCtx = ThreadTable.at(ActivePIDs.at(HartToExecID));
-
- //    /* Create the child ctx */
- //    uint32_t ChildPID = CreateChildCtx();
- //    std::shared_ptr<RevThread> ChildCtx = ThreadTable.at(ChildPID);
-
- //    /*
- //    * ===========================================================================================
- //    * Register File
- //    * ===========================================================================================
- //    * We need to duplicate the parent's RegFile to to the Childs
- //    * - NOTE: when we return from this function, the return value will
- //    *         be automatically stored in the Proc.RegFile[HartToExecID]'s a0
- //    *         register. In a traditional fork code this looks like:
- //    *
- //    *         pid_t pid = fork()
- //    *         if pid < 0: // Error
- //    *         else if pid = 0: // New Child Process
- //    *         else: // Parent Process
- //    *
- //    *         In this case, the value of pid is the value thats returned to a0
- //    *         It follows that
- //    *         - The child's regfile MUST have 0 in its a0 (despite its pid != 0 to the RevProc)
- //    *         - The Parent's a0 register MUST have its PID in it
- //    * ===========================================================================================
- //    */
-
- //    /*
- //    Alert the Proc there needs to be a Ctx switch
- //    Pass the PID that will be switched to once the
- //    current pipeline is executed until completion
- //    */
- //    CtxSwitchAlert(ChildPID);
-
- //    // Parent's return value is the child's PID
- //    RegFile->SetX(RevReg::a0, ChildPID);
-
- //    // Child's return value is 0
- //    ChildCtx->GetRegFile()->SetX(RevReg::a0, 0);
-
- //    // clean up ecall state
- //    rtval = EcallStatus::SUCCESS;
- //    ECALL.bytesRead = 0;
-
- //  } //else
-  return rtval;
+  auto flags      = RegFile->GetX<uint64_t>(RevReg::a0);
+  auto newsp      = RegFile->GetX<uint64_t>(RevReg::a1);
+  auto parent_tid = RegFile->GetX<uint64_t>(RevReg::a2);
+  auto tls        = RegFile->GetX<uint64_t>(RevReg::a3);
+  auto child_tid  = RegFile->GetX<uint64_t>(RevReg::a4);
+  return EcallClone(flags, newsp, parent_tid, tls, child_tid);
 }
 
 // 221, rev_execve(const char  *filename, const char  *const  *argv, const char  *const  *envp)
@@ -2931,151 +4017,27 @@ EcallStatus RevProc::ECALL_clone3(RevInst& inst){
   output->verbose(CALL_INFO, 2, 0,
                   "ECALL: clone3 called by thread %" PRIu32
                   " on hart %" PRIu32 "\n", ActiveThreadID, HartToExecID);
-  auto rtval = EcallStatus::SUCCESS;
- //  auto CloneArgsAddr = RegFile->GetX<uint64_t>(RevReg::a0);
- // auto SizeOfCloneArgs = RegFile()->GetX<size_t>(RevReg::a1);
-
- // if(0 == ECALL.bytesRead){
- //    // First time through the function...
- //    /* Fetch the clone_args */
- //    // struct clone_args args;  // So while clone_args is a whole struct, we appear to be only
- //                                // using the 1st uint64, so that's all we're going to fetch
- //   uint64_t* args = reinterpret_cast<uint64_t*>(ECALL.buf.data());
- //   mem->ReadVal<uint64_t>(HartToExecID, CloneArgsAddr, args, inst.hazard, RevFlag::F_NONE);
- //   ECALL.bytesRead = sizeof(*args);
- //   rtval = EcallStatus::CONTINUE;
- // }else{
- //    /*
- //    * Parse clone flags
- //    * NOTE: if no flags are set, we get fork() like behavior
- //    */
- //   uint64_t* args = reinterpret_cast<uint64_t*>(ECALL.buf.data());
- //    for( uint64_t bit=1; bit != 0; bit <<= 1 ){
- //      switch (*args & bit) {
- //        case CLONE_VM:
- //          // std::cout << "CLONE_VM is true" << std::endl;
- //          break;
- //        case CLONE_FS: /* Set if fs info shared between processes */
- //          // std::cout << "CLONE_FS is true" << std::endl;
- //          break;
- //        case CLONE_FILES: /* Set if open files shared between processes */
- //          // std::cout << "CLONE_FILES is true" << std::endl;
- //          break;
- //        case CLONE_SIGHAND: /* Set if signal handlers shared */
- //          // std::cout << "CLONE_SIGHAND is true" << std::endl;
- //          break;
- //        case CLONE_PIDFD: /* Set if a pidfd should be placed in the parent */
- //          // std::cout << "CLONE_PIDFD is true" << std::endl;
- //          break;
- //        case CLONE_PTRACE: /* Set if tracing continues on the child */
- //          // std::cout << "CLONE_PTRACE is true" << std::endl;
- //          break;
- //        case CLONE_VFORK: /* Set if the parent wants the child to wake it up on mm_release */
- //          // std::cout << "CLONE_VFORK is true" << std::endl;
- //          break;
- //        case CLONE_PARENT: /* Set if we want to have the same parent as the cloner */
- //          // std::cout << "CLONE_PARENT is true" << std::endl;
- //          break;
- //        case CLONE_THREAD: /* Set to add to same thread group */
- //          // std::cout << "CLONE_THREAD is true" << std::endl;
- //          break;
- //        case CLONE_NEWNS: /* Set to create new namespace */
- //          // std::cout << "CLONE_NEWNS is true" << std::endl;
- //          break;
- //        case CLONE_SYSVSEM: /* Set to shared SVID SEM_UNDO semantics */
- //          // std::cout << "CLONE_SYSVSEM is true" << std::endl;
- //          break;
- //        case CLONE_SETTLS: /* Set TLS info */
- //          // std::cout << "CLONE_SETTLS is true" << std::endl;
- //          break;
- //        case CLONE_PARENT_SETTID: /* Store TID in userlevel buffer before MM copy */
- //          // std::cout << "CLONE_PARENT_SETTID is true" << std::endl;
- //          break;
- //        case CLONE_CHILD_CLEARTID: /* Register exit futex and memory location to clear */
- //          // std::cout << "CLONE_CHILD_CLEARTID is true" << std::endl;
- //          break;
- //        case CLONE_DETACHED: /* Create clone detached */
- //          // std::cout << "CLONE_DETACHED is true" << std::endl;
- //          break;
- //        case CLONE_UNTRACED: /* Set if the tracing process can't force CLONE_PTRACE on this clone */
- //          // std::cout << "CLONE_UNTRACED is true" << std::endl;
- //          break;
- //        case CLONE_CHILD_SETTID: /* New cgroup namespace */
- //          // std::cout << "CLONE_CHILD_SETTID is true" << std::endl;
- //          break;
- //        case CLONE_NEWCGROUP: /* New cgroup namespace */
- //          // std::cout << "CLONE_NEWCGROUP is true" << std::endl;
- //          break;
- //        case CLONE_NEWUTS: /* New utsname group */
- //          // std::cout << "CLONE_NEWUTS is true" << std::endl;
- //          break;
- //        case CLONE_NEWIPC: /* New ipcs */
- //          // std::cout << "CLONE_NEWIPC is true" << std::endl;
- //          break;
- //        case CLONE_NEWUSER: /* New user namespace */
- //          // std::cout << "CLONE_NEWUSER is true" << std::endl;
- //          break;
- //        case CLONE_NEWPID: /* New pid namespace */
- //          // std::cout << "CLONE_NEWPID is true" << std::endl;
- //          break;
- //        case CLONE_NEWNET: /* New network namespace */
- //          // std::cout << "CLONE_NEWNET is true" << std::endl;
- //          break;
- //        case CLONE_IO: /* Clone I/O Context */
- //          // std::cout << "CLONE_IO is true" << std::endl;
- //          break;
- //        default:
- //          break;
- //      } // switch
- //    } // for
-
- //    /* Get the parent ctx (Current active, executing PID) */
- //    std::shared_ptr<RevThread> ParentCtx = ThreadTable.at(ActivePIDs.at(HartToExecID));
-
- //    /* Create the child ctx */
- //    uint32_t ChildPID = CreateChildCtx();
- //    std::shared_ptr<RevThread> ChildCtx = ThreadTable.at(ChildPID);
-
- //    /*
- //    * ===========================================================================================
- //    * Register File
- //    * ===========================================================================================
- //    * We need to duplicate the parent's RegFile to to the Childs
- //    * - NOTE: when we return from this function, the return value will
- //    *         be automatically stored in the Proc.RegFile[HartToExecID]'s a0
- //    *         register. In a traditional fork code this looks like:
- //    *
- //    *         pid_t pid = fork()
- //    *         if pid < 0: // Error
- //    *         else if pid = 0: // New Child Process
- //    *         else: // Parent Process
- //    *
- //    *         In this case, the value of pid is the value thats returned to a0
- //    *         It follows that
- //    *         - The child's regfile MUST have 0 in its a0 (despite its pid != 0 to the RevProc)
- //    *         - The Parent's a0 register MUST have its PID in it
- //    * ===========================================================================================
- //    */
-
- //    /*
- //    Alert the Proc there needs to be a Ctx switch
- //    Pass the PID that will be switched to once the
- //    current pipeline is executed until completion
- //    */
- //    CtxSwitchAlert(ChildPID);
-
- //    // Parent's return value is the child's PID
- //    RegFile->SetX(RevReg::a0, ChildPID);
-
- //    // Child's return value is 0
- //    ChildCtx->GetRegFile()->SetX(RevReg::a0, 0);
-
- //    // clean up ecall state
- //    rtval = EcallStatus::SUCCESS;
- //    ECALL.bytesRead = 0;
-
- //  } //else
-  return rtval;
+  auto uargs = RegFile->GetX<uint64_t>(RevReg::a0);
+  auto size  = RegFile->GetX<uint64_t>(RevReg::a1);
+
+  // CLONE_ARGS_SIZE_VER0: flags, pidfd, child_tid, parent_tid,
+  // exit_signal, stack, stack_size and tls; later fields are not used
+  constexpr size_t ArgsSizeVer0 = 8 * sizeof(uint64_t);
+  if( size < ArgsSizeVer0 ){
+    RegFile->SetX(RevReg::a0, -EINVAL);
+    return EcallStatus::SUCCESS;
+  }
+
+  EcallStatus rtval = EcallStatus::SUCCESS;
+  EcallStatus loaded = EcallLoadGuest(uargs, ArgsSizeVer0, [&](const char* data){
+    uint64_t args[8];
+    memcpy(args, data, sizeof(args));
+    uint64_t stack = args[5], stack_size = args[6];
+    // clone3 gives the lowest address of the stack rather than its top
+    rtval = EcallClone(args[0] | args[4], stack ? stack + stack_size : 0,
+                       args[3], args[7], args[2]);
+  });
+  return loaded == EcallStatus::SUCCESS ? rtval : loaded;
 }
 
 // 436, rev_close_range(unsigned int fd, unsigned int max_fd, unsigned int flags)
@@ -3146,6 +4108,16 @@ EcallStatus RevProc::ECALL_perf_stats(RevInst& inst){
   return EcallStatus::SUCCESS;
 }
 
+// 502, rev_trace_dump()
+EcallStatus RevProc::ECALL_trace_dump(RevInst& inst){
+  output->verbose(CALL_INFO, 2, 0, "ECALL: trace_dump called by thread %" PRIu32 "\n", GetActiveThreadID());
+  if( Tracer ){
+    Tracer->DumpFlightRecorder("rev_trace_dump by thread " + std::to_string(ActiveThreadID));
+  }
+  RegFile->SetX(RevReg::a0, 0);
+  return EcallStatus::SUCCESS;
+}
+
 // 1000, int pthread_create(pthread_t *restrict thread,
 //                          const pthread_attr_t *restrict attr,
 //                          void *(*start_routine)(void *),
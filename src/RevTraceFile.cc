@@ -0,0 +1,168 @@
+//
+// _RevTraceFile_cc_
+//
+// Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#include "RevTraceFile.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace SST::RevCPU{
+
+// Trace files still open; guest exit() and fatal errors end the simulation
+// without running the component destructors
+static std::vector<RevTraceFile*> OpenTraceFiles;
+
+RevTraceFile::RevTraceFile(const std::string& Path, unsigned Core){
+  Out.open(Path, std::ios::binary | std::ios::trunc);
+  Good = Out.write(Magic, sizeof(Magic)).good();
+  Block.reserve(BlockRecs);
+
+  static bool Registered = false;
+  if( !Registered ){
+    std::atexit(FlushAll);
+    Registered = true;
+  }
+  OpenTraceFiles.push_back(this);
+
+  TraceFileRec R{};
+  R.Kind = uint8_t(Kind::Core);
+  R.Aux  = Core;
+  Append(R);
+}
+
+RevTraceFile::~RevTraceFile(){
+  Flush();
+  OpenTraceFiles.erase(std::find(OpenTraceFiles.begin(), OpenTraceFiles.end(), this));
+}
+
+void RevTraceFile::FlushAll(){
+  for( auto* F : OpenTraceFiles )
+    F->Flush();
+}
+
+uint64_t RevTraceFile::Delta(uint64_t V, uint64_t& Last){
+  int64_t D = int64_t(V - Last);
+  Last = V;
+  return (uint64_t(D) << 1) ^ uint64_t(D >> 63);
+}
+
+void RevTraceFile::Append(const TraceFileRec& R){
+  Block.push_back(R);
+  if( Block.size() == BlockRecs )
+    Flush();
+}
+
+uint32_t RevTraceFile::AddString(const std::string& S){
+  TraceFileRec R{};
+  R.Kind = uint8_t(Kind::String);
+  R.Aux  = NextString;
+  R.A    = S.size();
+  Append(R);
+  for( size_t i = 0; i < S.size(); i += sizeof(R) ){
+    R = {};
+    memcpy(&R, S.data() + i, std::min(sizeof(R), S.size() - i));
+    Append(R);
+  }
+  return NextString++;
+}
+
+void RevTraceFile::Inst(uint64_t Cycle, unsigned Hart, unsigned Tid, uint64_t PC,
+                        uint32_t Insn, char Event, uint32_t Disasm){
+  TraceFileRec R{};
+  R.Kind = uint8_t(Kind::Inst);
+  R.Flag = uint8_t(Event);
+  R.Reg  = uint16_t(Hart);
+  R.Aux  = Disasm;
+  R.A    = Delta(Cycle, LastCycle);
+  R.B    = Delta(PC, LastPC);
+  R.C    = Insn | uint64_t(Tid) << 32;
+  Append(R);
+}
+
+void RevTraceFile::Reg(Kind K, uint64_t Reg, uint64_t V){
+  TraceFileRec R{};
+  R.Kind = uint8_t(K);
+  R.Reg  = uint16_t(Reg);
+  uint64_t& Last = LastReg[Reg % 256];
+  R.B    = V ^ Last;
+  Last   = V;
+  Append(R);
+}
+
+void RevTraceFile::Mem(Kind K, uint64_t Addr, uint64_t Len, uint64_t Data){
+  TraceFileRec R{};
+  R.Kind = uint8_t(K);
+  R.Aux  = uint32_t(Len);
+  R.A    = Delta(Addr, LastAddr);
+  if( K == Kind::MemhLoad ){
+    R.Reg = uint16_t(Data);
+  }else{
+    R.C   = Data;
+  }
+  Append(R);
+}
+
+void RevTraceFile::PcWrite(uint64_t NewPC, uint32_t Symbol){
+  // relative to the instruction, without moving the instruction PC delta
+  uint64_t Base = LastPC;
+  TraceFileRec R{};
+  R.Kind = uint8_t(Kind::PcWrite);
+  R.Aux  = Symbol;
+  R.A    = Delta(NewPC, Base);
+  Append(R);
+}
+
+void RevTraceFile::Completion(unsigned Hart, uint16_t DestReg, uint64_t Len, uint64_t Addr,
+                              uint64_t Data, bool IsFloat){
+  TraceFileRec R{};
+  R.Kind = uint8_t(Kind::Completion);
+  R.Flag = IsFloat;
+  R.Reg  = DestReg;
+  R.Aux  = uint32_t(Len);
+  R.A    = Delta(Addr, LastAddr);
+  R.B    = Hart;
+  R.C    = Data;
+  Append(R);
+}
+
+void RevTraceFile::Flush(){
+  if( Block.empty() )
+    return;
+
+  // replace runs of zero bytes with a count, copy everything else
+  const auto* Raw = reinterpret_cast<const unsigned char*>(Block.data());
+  const size_t Len = Block.size() * sizeof(TraceFileRec);
+  Packed.clear();
+  for( size_t i = 0; i < Len; ){
+    size_t n = 0;
+    if( !Raw[i] ){
+      while( i + n < Len && n < 128 && !Raw[i + n] )
+        n++;
+      Packed.push_back(char(0x7f + n));
+    }else{
+      // a lone zero is cheaper inside the literal than as its own run
+      while( i + n < Len && n < 128 &&
+             ( Raw[i + n] || (i + n + 1 < Len && Raw[i + n + 1]) ) )
+        n++;
+      Packed.push_back(char(n - 1));
+      Packed.insert(Packed.end(), Raw + i, Raw + i + n);
+    }
+    i += n;
+  }
+
+  uint32_t Hdr[2] = {uint32_t(Len), uint32_t(Packed.size())};
+  Out.write(reinterpret_cast<const char*>(Hdr), sizeof(Hdr));
+  Out.write(Packed.data(), std::streamsize(Packed.size()));
+  Out.flush();
+  Good = Good && Out.good();
+  Block.clear();
+}
+
+} // namespace SST::RevCPU
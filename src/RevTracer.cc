@@ -12,13 +12,30 @@
 #include <sstream>
 #include <iomanip>
 #include <string>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
 
 #include "RevTracer.h"
 
 namespace SST::RevCPU{
 
+// Tracers still alive; a guest exit() ends the simulation without
+// running the component destructors or finish()
+static std::vector<RevTracer*> LiveTracers;
+
 RevTracer::RevTracer(std::string Name, SST::Output *o): name(Name), pOutput(o) {
 
+    static bool registered = false;
+    if (!registered) {
+        std::atexit(ExitAll);
+        registered = true;
+    }
+    LiveTracers.push_back(this);
+
+    // tracers may exist only for a binary trace or the flight recorder
+    renderText = pOutput->getVerboseLevel() >= 5;
+
     enableQ.resize(MAX_ENABLE_Q);
     enableQ.assign(MAX_ENABLE_Q,0);
     enableQindex = 0;
@@ -44,6 +61,8 @@ RevTracer::RevTracer(std::string Name, SST::Output *o): name(Name), pOutput(o) {
 
 RevTracer::~RevTracer()
 {
+    StopWriter();
+    LiveTracers.erase(std::find(LiveTracers.begin(), LiveTracers.end(), this));
     #ifdef REV_USE_SPIKE
     if (diasm) delete diasm;
     if (isaParser) delete isaParser;
@@ -52,6 +71,8 @@ RevTracer::~RevTracer()
 
 int RevTracer::SetDisassembler(std::string machine)
 {
+    // C.JAL only exists in RV32
+    rv32 = machine.find("32") != std::string::npos;
     #ifdef REV_USE_SPIKE
     try {
         // TODO privelege level options
@@ -66,6 +87,175 @@ int RevTracer::SetDisassembler(std::string machine)
     #endif
 }
 
+int RevTracer::SetBinaryFile(const std::string& path, unsigned core)
+{
+    binFile = std::make_unique<RevTraceFile>(path, core);
+    return binFile->IsOpen() ? 0 : 1;
+}
+
+void RevTracer::SetAsyncWriter(size_t depth, bool drop)
+{
+    asyncQ = std::make_unique<RevTraceQueue<TraceItem_t>>(depth);
+    dropWhenFull = drop;
+    // SST::Output is not thread safe; the writer prints through its own
+    writerOutput = std::make_unique<SST::Output>("", pOutput->getVerboseLevel(), 0,
+                                                 pOutput->getOutputLocation());
+    writer = std::thread(&RevTracer::WriterLoop, this);
+}
+
+void RevTracer::Drain()
+{
+    while (asyncQ && !asyncQ->Empty())
+        std::this_thread::yield();
+    if (dropped != droppedReported) {
+        pOutput->verbose(CALL_INFO, 1, 0,
+                         "Warning: trace writer queue was full; %" PRIu64 " trace records dropped\n",
+                         dropped - droppedReported);
+        droppedReported = dropped;
+    }
+}
+
+void RevTracer::StopWriter()
+{
+    if (!writer.joinable())
+        return;
+    writerStop.store(true, std::memory_order_release);
+    writer.join();
+}
+
+void RevTracer::ExitAll()
+{
+    for (auto* trc : LiveTracers) {
+        trc->DumpFlightRecorder("exit");
+        trc->StopWriter();
+        trc->Flush();
+    }
+}
+
+TraceItem_t* RevTracer::ClaimItem()
+{
+    // back-pressure: wait for the writer, or drop and count the record
+    TraceItem_t* item = asyncQ->Claim();
+    while (!item) {
+        if (dropWhenFull) {
+            dropped++;
+            return nullptr;
+        }
+        std::this_thread::yield();
+        item = asyncQ->Claim();
+    }
+    return item;
+}
+
+void RevTracer::WriterLoop()
+{
+    // branch rendering state, as RevTracer::lastPC in queue order
+    uint64_t lastpc = 0;
+    unsigned idle = 0;
+    for (;;) {
+        TraceItem_t* item = asyncQ->Front();
+        if (!item) {
+            if (writerStop.load(std::memory_order_acquire) && asyncQ->Empty())
+                return;
+            // back off while the simulation produces nothing
+            if (++idle < 64)
+                std::this_thread::yield();
+            else
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            continue;
+        }
+        idle = 0;
+
+        // the prefix mirrors the logging prefix, with the cycle instead of the time
+        std::string line;
+        {
+            std::lock_guard<std::mutex> lock(formatMutex);
+            line = item->completion
+                 ? FormatCompletion(item->destReg, item->len, item->pc, item->data)
+                 : FormatExec(item->pc, item->insn, item->event, item->recs, *item->mnemonic, lastpc);
+        }
+        if (item->completion) {
+            writerOutput->output("RevCPU[%s:Render:%zu]: Hart %" PRIu32 "; *A %s\n",
+                                 name.c_str(), item->cycle, item->hart, line.c_str());
+        } else {
+            writerOutput->output("RevCPU[%s:Render:%zu]: Core %" PRIu32 "; Hart %" PRIu32 "; Thread %" PRIu32 "; *I %s\n",
+                                 name.c_str(), item->cycle, item->id, item->hart, item->tid, line.c_str());
+        }
+        item->recs.clear();
+        asyncQ->Pop();
+    }
+}
+
+int RevTracer::SetTraceFilter(const std::vector<std::pair<uint64_t,uint64_t>>& ranges,
+                              const std::vector<unsigned>& harts, const std::vector<unsigned>& tids)
+{
+    // Ranges are flattened into a bitmap spanning the lowest to the highest
+    // address so the per instruction check is a single bit test
+    pcBits.clear();
+    if (!ranges.empty()) {
+        uint64_t lo = UINT64_MAX, hi = 0;
+        for (auto& r : ranges) {
+            if (r.first >= r.second)
+                return 1;
+            lo = std::min(lo, r.first);
+            hi = std::max(hi, r.second);
+        }
+        pcBase = lo & ~uint64_t(1);
+        pcSlots = (hi - pcBase + 1) >> 1;
+        if (pcSlots > MAX_FILTER_SLOTS)
+            return 1;
+        pcBits.assign((pcSlots + 63) >> 6, 0);
+        for (auto& r : ranges) {
+            for (uint64_t slot = (r.first - pcBase) >> 1; slot < ((r.second - pcBase + 1) >> 1); slot++)
+                pcBits[slot >> 6] |= uint64_t(1) << (slot & 63);
+        }
+    }
+
+    filterHarts.clear();
+    for (unsigned h : harts) {
+        if (h >= filterHarts.size())
+            filterHarts.resize(h + 1);
+        filterHarts[h] = true;
+    }
+
+    filterTids = std::unordered_set<unsigned>(tids.begin(), tids.end());
+    return 0;
+}
+
+int RevTracer::AddTraceClass(const std::string& cls)
+{
+    auto it = s2class.find(cls);
+    if (it == s2class.end())
+        return 1;
+    filterClass |= static_cast<unsigned>(it->second);
+    return 0;
+}
+
+unsigned RevTracer::InstClass() const
+{
+    unsigned c = 0;
+    for (auto& r : traceRecs) {
+        if (r.key == MemLoad || r.key == MemStore || r.key == MemhSendLoad)
+            c |= static_cast<unsigned>(TRC_CLASS::MEM);
+    }
+
+    // branches are classified by opcode; a PC write is only seen when taken
+    bool branch;
+    if ((insn & 0b11) == 0b11) {
+        uint32_t opcode = insn & 0x7f;
+        branch = opcode == 0b1100011 || opcode == 0b1101111 || opcode == 0b1100111; // BRANCH, JAL, JALR
+    } else {
+        uint32_t op = insn & 0b11, funct3 = (insn >> 13) & 0b111;
+        if (op == 0b01) // C.J, C.BEQZ, C.BNEZ, C.JAL (RV32)
+            branch = funct3 == 0b101 || funct3 == 0b110 || funct3 == 0b111 || (rv32 && funct3 == 0b001);
+        else            // C.JR, C.JALR: rs1 != 0, rs2 == 0
+            branch = op == 0b10 && funct3 == 0b100 && ((insn >> 7) & 0x1f) && !((insn >> 2) & 0x1f);
+    }
+    if (branch)
+        c |= static_cast<unsigned>(TRC_CLASS::BRANCH);
+    return c;
+}
+
 void RevTracer::SetTraceSymbols(std::map<uint64_t, std::string> *TraceSymbols)
 {
     traceSymbols = TraceSymbols;
@@ -180,13 +370,18 @@ void RevTracer::memRead(uint64_t adr, size_t len, void *data)
     traceRecs.emplace_back(TraceRec_t(MemLoad,adr,len,d));
 }
 
-void SST::RevCPU::RevTracer::memhSendRead(uint64_t adr, size_t len, uint16_t reg)
+void SST::RevCPU::RevTracer::memhSendRead(uint64_t adr, size_t len, const MemReq& req)
 {
-    traceRecs.emplace_back(TraceRec_t(MemhSendLoad, adr, len, reg));
+    traceRecs.emplace_back(TraceRec_t(MemhSendLoad, adr, len, req.DestReg));
+    pendingLoads.insert(req.LSQHash());
 }
 
 void RevTracer::memReadResponse(size_t len, void *data, const MemReq* req)
 {
+    // the controller reports every load; only those of traced instructions pass the filter
+    auto it = pendingLoads.find(req->LSQHash());
+    if (it == pendingLoads.end()) return;
+    pendingLoads.erase(it);
     if (req->DestReg==0) return;
     CompletionRec_t c(req->Hart, req->DestReg, len, req->Addr, data, req->RegType);
     completionRecs.emplace_back(c);
@@ -214,15 +409,31 @@ void RevTracer::Render(size_t cycle)
 
     // memory completions
     if (completionRecs.size()>0) {
-        if (OutputOK()) {
+        if (OutputOK() && (binFile || renderText)) {
             for (auto r : completionRecs) {
-                std::string data_str = fmt_data(r.len, r.data);
-                std::stringstream s;
-                s << data_str << "<-[0x" << std::hex << r.addr << "," << std::dec << r.len << "] ";
-                s << fmt_reg(r.destReg) << "<-" << data_str << " "; 
+                // address, hart and thread filters were applied when the load was issued
+                if (filterClass && !(filterClass & static_cast<unsigned>(TRC_CLASS::MEM)))
+                    continue;
+                if (binFile) {
+                    binFile->Completion(r.hart, r.destReg, r.len, r.addr, r.data, r.isFloat);
+                    continue;
+                }
+                if (asyncQ) {
+                    if (TraceItem_t* item = ClaimItem()) {
+                        item->completion = true;
+                        item->cycle = cycle;
+                        item->hart = r.hart;
+                        item->destReg = r.destReg;
+                        item->len = r.len;
+                        item->pc = r.addr;
+                        item->data = r.data;
+                        asyncQ->Publish();
+                    }
+                    continue;
+                }
                 pOutput->verbose(CALL_INFO, 5, 0,
                                 "Hart %" PRIu32 "; *A %s\n",
-                                r.hart, s.str().c_str());
+                                r.hart, FormatCompletion(r.destReg, r.len, r.addr, r.data).c_str());
             }
         }
         // reset completion reqs
@@ -231,12 +442,28 @@ void RevTracer::Render(size_t cycle)
 
     // Instruction Trace
     if (instHeader.valid) {
-        if (OutputOK()){
+        // instructions outside the address, hart and thread filters are never captured
+        bool keep = !filterClass || (InstClass() & filterClass);
+        if (keep && ringSize)
+            RecordFlight();
+        if (!keep) {
+            // dropped by the instruction class filter
+        } else if (OutputOK() && binFile) {
+            WriteExec(*instHeader.fallbackMnemonic);
+        } else if (OutputOK() && renderText && asyncQ) {
+            QueueExec();
+        } else if (OutputOK() && renderText) {
             pOutput->verbose(CALL_INFO, 5, 0,
                             "Core %" PRIu32 "; Hart %" PRIu32 "; Thread %" PRIu32 "; *I %s\n",
-                            instHeader.id, instHeader.hart, instHeader.tid, RenderExec(instHeader.fallbackMnemonic).c_str());
+                            instHeader.id, instHeader.hart, instHeader.tid, RenderExec(*instHeader.fallbackMnemonic).c_str());
         }
+        bool dump = !dumpPCs.empty() && dumpPCs.count(pc);
         InstTraceReset();
+        if (dump) {
+            std::stringstream s;
+            s << "pc 0x" << std::hex << pc;
+            DumpFlightRecorder(s.str());
+        }
     }
 
 }
@@ -247,16 +474,59 @@ void SST::RevCPU::RevTracer::Reset()
     completionRecs.clear();
 }
 
+void RevTracer::QueueExec()
+{
+    // Same content as RenderExec; WriterLoop does the formatting
+    if (!traceRecs.empty())
+        traceCycles++;
+    TraceItem_t* item = ClaimItem();
+    if (!item)
+        return;
+    item->completion = false;
+    item->cycle = instHeader.cycle;
+    item->id = instHeader.id;
+    item->hart = instHeader.hart;
+    item->tid = instHeader.tid;
+    item->pc = pc;
+    item->insn = insn;
+    item->event = EventSymbol();
+    item->mnemonic = instHeader.fallbackMnemonic;
+    // the slot's empty buffer becomes the next capture buffer
+    item->recs.swap(traceRecs);
+    asyncQ->Publish();
+}
+
+std::string RevTracer::FormatCompletion(uint16_t destReg, size_t len, uint64_t addr, uint64_t data)
+{
+    std::string data_str = fmt_data(len, data);
+    std::stringstream s;
+    s << data_str << "<-[0x" << std::hex << addr << "," << std::dec << len << "] ";
+    s << fmt_reg(destReg) << "<-" << data_str << " ";
+    return s.str();
+}
+
+char RevTracer::EventSymbol()
+{
+    if (events.v && events.f.trc_ctl)
+        return event2char.at(outputEnabled ? EVENT_SYMBOL::TRACE_ON : EVENT_SYMBOL::TRACE_OFF);
+    return 0;
+}
+
 std::string RevTracer::RenderExec(const std::string& fallbackMnemonic)
+{
+    // We got something, count it
+    if (!traceRecs.empty())
+        traceCycles++;
+    return FormatExec(pc, insn, EventSymbol(), traceRecs, fallbackMnemonic, lastPC);
+}
+
+std::string RevTracer::FormatExec(uint64_t pc, uint32_t insn, char event, const std::vector<TraceRec_t>& recs,
+                                  const std::string& fallbackMnemonic, uint64_t& lastpc)
 {
     // Flow Control Events
     std::stringstream ss_events;
-    if (events.v) {
-        if (events.f.trc_ctl) {
-            EVENT_SYMBOL e = outputEnabled ? EVENT_SYMBOL::TRACE_ON : EVENT_SYMBOL::TRACE_OFF;
-            ss_events << event2char.at(e);
-        }
-    }
+    if (event)
+        ss_events << event;
 
     // Disassembly
     std::stringstream ss_disasm;
@@ -286,12 +556,9 @@ std::string RevTracer::RenderExec(const std::string& fallbackMnemonic)
     os << " " << std::setfill(' ') << std::setw(2) << ss_events.str() << " " << ss_disasm.str();
 
     // register and memory read/write events preserving code ordering
-    if (traceRecs.empty())
+    if (recs.empty())
         return os.str();
 
-    // We got something, count it and render it
-    traceCycles++;
-    
     // For Memh, the target register is corrupted after ReadVal (See RevInstHelpers.h::load) 
     // This is a transitory value that would only be observed if the register file is accessible
     // by an external agent (e.g. IO or JTAG scan). A functional issue would occur
@@ -303,7 +570,7 @@ std::string RevTracer::RenderExec(const std::string& fallbackMnemonic)
     bool squashNextSetX = false;
 
     std::stringstream ss_rw;
-    for (TraceRec_t r : traceRecs) {
+    for (const TraceRec_t& r : recs) {
         switch (r.key) {
             case RegRead:
                 // a:reg b:data
@@ -338,15 +605,15 @@ std::string RevTracer::RenderExec(const std::string& fallbackMnemonic)
                 break;
             case PcWrite:
                 // a:pc
-                uint64_t pc = r.a;
-                if ( lastPC+4 != pc ) {
+                uint64_t newpc = r.a;
+                if ( lastpc+4 != newpc ) {
                     // only render if non-sequential instruction
-                    ss_rw << "pc<-0x" << std::hex << pc;
-                    if (traceSymbols and (traceSymbols->find(pc) != traceSymbols->end()))
-                        ss_rw << " <" << traceSymbols->at(pc) << ">";
+                    ss_rw << "pc<-0x" << std::hex << newpc;
+                    if (traceSymbols and (traceSymbols->find(newpc) != traceSymbols->end()))
+                        ss_rw << " <" << traceSymbols->at(newpc) << ">";
                     ss_rw << " ";
                 }
-                lastPC = pc;
+                lastpc = newpc;
                 break;
         }
     }
@@ -356,6 +623,126 @@ std::string RevTracer::RenderExec(const std::string& fallbackMnemonic)
     return os.str();
 }
 
+uint32_t RevTracer::DisasmID(const std::string& fallbackMnemonic)
+{
+    // each distinct disassembly is stored once and referenced by id
+    #ifdef REV_USE_SPIKE
+    if (diasm) {
+        const void* key = reinterpret_cast<const void*>(uintptr_t(insn));
+        auto it = disasmIDs.find(key);
+        if (it == disasmIDs.end())
+            it = disasmIDs.emplace(key, binFile->AddString(diasm->disassemble(insn))).first;
+        return it->second;
+    }
+    #endif
+    auto it = disasmIDs.find(&fallbackMnemonic);
+    if (it == disasmIDs.end())
+        it = disasmIDs.emplace(&fallbackMnemonic, binFile->AddString(fallbackMnemonic)).first;
+    return it->second;
+}
+
+void RevTracer::WriteExec(const std::string& fallbackMnemonic)
+{
+    // Same content as RenderExec; scripts/revtrace.py does the formatting
+    binFile->Inst(instHeader.cycle, instHeader.hart, instHeader.tid, pc, insn, EventSymbol(),
+                  DisasmID(fallbackMnemonic));
+    if (traceRecs.empty())
+        return;
+    traceCycles++;
+
+    for (const TraceRec_t& r : traceRecs) {
+        switch (r.key) {
+            case RegRead:
+                binFile->Reg(RevTraceFile::Kind::RegRead, r.a, r.b);
+                break;
+            case RegWrite:
+                binFile->Reg(RevTraceFile::Kind::RegWrite, r.a, r.b);
+                break;
+            case MemStore:
+                binFile->Mem(RevTraceFile::Kind::MemStore, r.a, r.b, r.c);
+                break;
+            case MemLoad:
+                binFile->Mem(RevTraceFile::Kind::MemLoad, r.a, r.b, r.c);
+                break;
+            case MemhSendLoad:
+                binFile->Mem(RevTraceFile::Kind::MemhLoad, r.a, r.b, r.c);
+                break;
+            case PcWrite:
+            {
+                uint32_t sym = 0;
+                if (lastPC+4 != r.a && traceSymbols) {
+                    auto s = traceSymbols->find(r.a);
+                    if (s != traceSymbols->end()) {
+                        auto it = symbolIDs.find(r.a);
+                        if (it == symbolIDs.end())
+                            it = symbolIDs.emplace(r.a, binFile->AddString(s->second)).first;
+                        sym = it->second;
+                    }
+                }
+                binFile->PcWrite(r.a, sym);
+                lastPC = r.a;
+                break;
+            }
+        }
+    }
+}
+
+void RevTracer::RecordFlight()
+{
+    if (instHeader.hart >= rings.size())
+        rings.resize(instHeader.hart + 1);
+    FlightRing_t& ring = rings[instHeader.hart];
+
+    // a dump empties the ring, which then refills from slot 0
+    FlightRec_t* rec;
+    if (ring.count < ringSize) {
+        if (ring.count == ring.recs.size())
+            ring.recs.emplace_back();
+        rec = &ring.recs[ring.count++];
+    } else {
+        rec = &ring.recs[ring.head];
+        ring.head = (ring.head + 1) % ringSize;
+    }
+    rec->cycle = instHeader.cycle;
+    rec->id = instHeader.id;
+    rec->tid = instHeader.tid;
+    rec->pc = pc;
+    rec->insn = insn;
+    rec->mnemonic = instHeader.fallbackMnemonic;
+    rec->recs.assign(traceRecs.begin(), traceRecs.end());
+}
+
+void RevTracer::DumpFlightRecorder(const std::string& reason)
+{
+    // the queued trace comes first
+    Drain();
+    for (unsigned hart = 0; hart < rings.size(); hart++) {
+        FlightRing_t& ring = rings[hart];
+        if (!ring.count)
+            continue;
+        pOutput->verbose(CALL_INFO, 0, 0,
+                         "Flight recorder dump (%s): last %zu instructions of Hart %" PRIu32 "\n",
+                         reason.c_str(), ring.count, hart);
+        uint64_t lastpc = 0;
+        for (size_t i = 0; i < ring.count; i++) {
+            const FlightRec_t& r = ring.recs[(ring.head + i) % ring.count];
+            std::string line;
+            {
+                // the writer thread may still be formatting
+                std::lock_guard<std::mutex> lock(formatMutex);
+                line = FormatExec(r.pc, r.insn, 0, r.recs, *r.mnemonic, lastpc);
+            }
+            pOutput->verbose(CALL_INFO, 0, 0,
+                             "Core %" PRIu32 "; Hart %" PRIu32 "; Thread %" PRIu32 "; Cycle %zu; *F %s\n",
+                             r.id, hart, r.tid, r.cycle, line.c_str());
+        }
+        // a later dump only shows what ran since this one; the slots and
+        // their record buffers are reused
+        ring.count = 0;
+        ring.head = 0;
+    }
+}
+
 void RevTracer::InstTraceReset()
 {
     events.v = 0;
@@ -0,0 +1,345 @@
+//
+// _RevVFS_cc_
+//
+// Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#include "RevVFS.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <dirent.h>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace SST::RevCPU{
+
+RevVFS::RevVFS(const std::string& Cwd){
+  Resolve(FDCWD, Cwd, this->Cwd);
+  CreateDirs(this->Cwd);
+}
+
+int RevVFS::Resolve(int DirFd, const std::string& Path, std::string& Abs) const {
+  if( Path.empty() )
+    return -ENOENT;
+
+  std::filesystem::path P(Path);
+  if( P.is_relative() ){
+    std::string Base = Cwd;
+    if( DirFd != FDCWD ){
+      auto it = Files.find(DirFd);
+      if( it == Files.end() )
+        return -EBADF;
+      if( !it->second.Inode->Dir )
+        return -ENOTDIR;
+      Base = it->second.Path;
+    }
+    P = std::filesystem::path(Base) / P;
+  }
+
+  Abs = P.lexically_normal().string();
+  if( Abs.size() > 1 && Abs.back() == '/' )
+    Abs.pop_back();
+  return 0;
+}
+
+std::shared_ptr<RevVFS::Node> RevVFS::Create(const std::string& Abs, bool Dir, mode_t Perm){
+  auto N = std::make_shared<Node>(Node{Dir, Perm, NextIno++});
+  Nodes[Abs] = N;
+  return N;
+}
+
+void RevVFS::CreateDirs(const std::string& Abs){
+  std::filesystem::path Prefix;
+  for( const auto& Part : std::filesystem::path(Abs) ){
+    Prefix /= Part;
+    if( !Nodes.count(Prefix.string()) )
+      Create(Prefix.string(), true, 0755);
+  }
+}
+
+bool RevVFS::ParentIsDir(const std::string& Abs) const {
+  auto it = Nodes.find(std::filesystem::path(Abs).parent_path().string());
+  return it != Nodes.end() && it->second->Dir;
+}
+
+std::vector<std::string> RevVFS::Children(const std::string& Abs) const {
+  // the entries of a directory are the paths directly below it, in name order
+  std::string Prefix = Abs == "/" ? Abs : Abs + "/";
+  std::vector<std::string> Out;
+  for( auto it = Nodes.lower_bound(Prefix);
+       it != Nodes.end() && it->first.compare(0, Prefix.size(), Prefix) == 0; ++it ){
+    if( it->first.size() > Prefix.size() &&
+        it->first.find('/', Prefix.size()) == std::string::npos )
+      Out.push_back(it->first);
+  }
+  return Out;
+}
+
+bool RevVFS::Preload(const std::string& Path){
+  std::string Abs;
+  if( Resolve(FDCWD, Path, Abs) )
+    return false;
+
+  auto Load = [this](const std::filesystem::path& Host, const std::string& Dst){
+    std::ifstream In(Host, std::ios::binary);
+    if( !In.is_open() )
+      return false;
+    CreateDirs(std::filesystem::path(Dst).parent_path().string());
+    auto Perm = std::filesystem::status(Host).permissions() & std::filesystem::perms::mask;
+    auto N = Create(Dst, false, mode_t(Perm));
+    N->Data.assign(std::istreambuf_iterator<char>(In), std::istreambuf_iterator<char>());
+    return !In.bad();
+  };
+
+  std::error_code ec;
+  if( !std::filesystem::is_directory(Path, ec) )
+    return Load(Path, Abs);
+
+  CreateDirs(Abs);
+  for( const auto& E : std::filesystem::recursive_directory_iterator(Path, ec) ){
+    std::string Dst = (std::filesystem::path(Abs) / E.path().lexically_relative(Path)).string();
+    if( E.is_directory(ec) ){
+      CreateDirs(Dst);
+    }else if( E.is_regular_file(ec) && !Load(E.path(), Dst) ){
+      return false;
+    }
+  }
+  return !ec;
+}
+
+bool RevVFS::Dump(const std::string& Dir) const {
+  std::error_code ec;
+  for( const auto& [Path, N] : Nodes ){
+    std::filesystem::path Dst = std::filesystem::path(Dir) / std::filesystem::path(Path).relative_path();
+    if( N->Dir ){
+      std::filesystem::create_directories(Dst, ec);
+      if( ec )
+        return false;
+      continue;
+    }
+    std::filesystem::create_directories(Dst.parent_path(), ec);
+    std::ofstream Out(Dst, std::ios::binary | std::ios::trunc);
+    Out.write(N->Data.data(), std::streamsize(N->Data.size()));
+    if( ec || !Out )
+      return false;
+  }
+  return true;
+}
+
+int RevVFS::Open(int DirFd, const std::string& Path, int Flags, mode_t Mode){
+  std::string Abs;
+  if( int rc = Resolve(DirFd, Path, Abs) )
+    return rc;
+
+  int Acc = Flags & ACCMODE;
+  std::shared_ptr<Node> N;
+  auto it = Nodes.find(Abs);
+  if( it == Nodes.end() ){
+    if( !(Flags & CREAT) )
+      return -ENOENT;
+    if( !ParentIsDir(Abs) )
+      return -ENOENT;
+    N = Create(Abs, false, Mode & 0777);
+  }else{
+    N = it->second;
+    if( (Flags & CREAT) && (Flags & EXCL) )
+      return -EEXIST;
+    if( N->Dir && Acc != RDONLY )
+      return -EISDIR;
+    if( !N->Dir && (Flags & DIRECTORY) )
+      return -ENOTDIR;
+    if( !N->Dir && (Flags & TRUNC) && Acc != RDONLY )
+      N->Data.clear();
+  }
+
+  // lowest free descriptor, as the kernel would hand out
+  int fd = FirstFD;
+  for( const auto& F : Files ){
+    if( F.first != fd )
+      break;
+    fd++;
+  }
+  Files.emplace(fd, File{Abs, std::move(N), Flags, 0});
+  return fd;
+}
+
+int RevVFS::Close(int fd){
+  return Files.erase(fd) ? 0 : -EBADF;
+}
+
+ssize_t RevVFS::IO(bool Write, int fd, const std::vector<iovec>& Iov, const off_t *Pos){
+  auto it = Files.find(fd);
+  if( it == Files.end() )
+    return -EBADF;
+
+  File& F = it->second;
+  int Acc = F.Flags & ACCMODE;
+  if( Write ? Acc == RDONLY : Acc == WRONLY )
+    return -EBADF;
+  if( F.Inode->Dir )
+    return -EISDIR;
+  if( Pos && *Pos < 0 )
+    return -EINVAL;
+
+  auto& Data = F.Inode->Data;
+  size_t Off = Pos ? *Pos : F.Offset;
+  // like Linux, O_APPEND writes go to the end even when positioned
+  if( Write && (F.Flags & APPEND) )
+    Off = Data.size();
+
+  ssize_t Total = 0;
+  for( const auto& V : Iov ){
+    char *Buf = static_cast<char*>(V.iov_base);
+    if( Write ){
+      if( Off + V.iov_len > Data.size() )
+        Data.resize(Off + V.iov_len);
+      memcpy(Data.data() + Off, Buf, V.iov_len);
+      Off   += V.iov_len;
+      Total += V.iov_len;
+    }else{
+      size_t N = Off < Data.size() ? std::min(V.iov_len, Data.size() - Off) : 0;
+      memcpy(Buf, Data.data() + Off, N);
+      Off   += N;
+      Total += N;
+      if( N < V.iov_len )
+        break;
+    }
+  }
+
+  if( !Pos )
+    F.Offset = off_t(Off);
+  return Total;
+}
+
+off_t RevVFS::Seek(int fd, off_t Offset, int Whence){
+  auto it = Files.find(fd);
+  if( it == Files.end() )
+    return -EBADF;
+
+  File& F = it->second;
+  off_t Base;
+  switch( Whence ){
+  case SEEK_SET:
+    Base = 0;
+    break;
+  case SEEK_CUR:
+    Base = F.Offset;
+    break;
+  case SEEK_END:
+    Base = off_t(F.Inode->Data.size());
+    break;
+  default:
+    return -EINVAL;
+  }
+  if( Base + Offset < 0 )
+    return -EINVAL;
+  F.Offset = Base + Offset;
+  return F.Offset;
+}
+
+int RevVFS::GetStat(int fd, Stat& St) const {
+  auto it = Files.find(fd);
+  if( it == Files.end() )
+    return -EBADF;
+
+  const Node& N = *it->second.Inode;
+  St.Ino  = N.Ino;
+  St.Mode = (N.Dir ? S_IFDIR : S_IFREG) | N.Perm;
+  St.Size = int64_t(N.Data.size());
+  return 0;
+}
+
+ssize_t RevVFS::GetDents(int fd, size_t Len, std::vector<char>& Out){
+  auto it = Files.find(fd);
+  if( it == Files.end() )
+    return -EBADF;
+
+  File& F = it->second;
+  if( !F.Inode->Dir )
+    return -ENOTDIR;
+
+  // the directory offset indexes ".", ".." and then the entries in name order
+  std::vector<std::string> Entries = Children(F.Path);
+  const size_t Start = Out.size();
+  for( size_t i = size_t(F.Offset); i < Entries.size() + 2; i++ ){
+    std::string Name;
+    std::shared_ptr<Node> N;
+    if( i == 0 ){
+      Name = ".";
+      N = F.Inode;
+    }else if( i == 1 ){
+      Name = "..";
+      auto P = Nodes.find(std::filesystem::path(F.Path).parent_path().string());
+      N = P != Nodes.end() ? P->second : F.Inode;
+    }else{
+      Name = Entries[i-2].substr(Entries[i-2].rfind('/') + 1);
+      N = Nodes.at(Entries[i-2]);
+    }
+
+    // d_ino, d_off, d_reclen and d_type, then the name padded to 8 bytes
+    uint16_t RecLen = uint16_t((19 + Name.size() + 1 + 7) & ~size_t(7));
+    if( Out.size() - Start + RecLen > Len ){
+      if( Out.size() == Start )
+        return -EINVAL;
+      break;
+    }
+    int64_t Next = int64_t(i + 1);
+    uint8_t Type = N->Dir ? DT_DIR : DT_REG;
+    size_t At = Out.size();
+    Out.resize(At + RecLen, 0);
+    memcpy(&Out[At], &N->Ino, sizeof(uint64_t));
+    memcpy(&Out[At + 8], &Next, sizeof(Next));
+    memcpy(&Out[At + 16], &RecLen, sizeof(RecLen));
+    memcpy(&Out[At + 18], &Type, sizeof(Type));
+    memcpy(&Out[At + 19], Name.data(), Name.size());
+    F.Offset = off_t(i + 1);
+  }
+  return ssize_t(Out.size() - Start);
+}
+
+int RevVFS::Unlink(int DirFd, const std::string& Path, int Flags){
+  std::string Abs;
+  if( int rc = Resolve(DirFd, Path, Abs) )
+    return rc;
+
+  auto it = Nodes.find(Abs);
+  if( it == Nodes.end() )
+    return -ENOENT;
+
+  // open descriptors keep the node alive
+  if( Flags & REMOVEDIR ){
+    if( !it->second->Dir )
+      return -ENOTDIR;
+    if( Abs == "/" )
+      return -EBUSY;
+    if( !Children(Abs).empty() )
+      return -ENOTEMPTY;
+  }else if( it->second->Dir ){
+    return -EISDIR;
+  }
+  Nodes.erase(it);
+  return 0;
+}
+
+int RevVFS::Mkdir(int DirFd, const std::string& Path, mode_t Mode){
+  std::string Abs;
+  if( int rc = Resolve(DirFd, Path, Abs) )
+    return rc;
+
+  if( Nodes.count(Abs) )
+    return -EEXIST;
+  if( !ParentIsDir(Abs) )
+    return -ENOENT;
+  Create(Abs, true, Mode & 0777);
+  return 0;
+}
+
+} // namespace SST::RevCPU
@@ -28,6 +28,10 @@ parser.add_argument("--verbose", type=int, help="Verbosity level", default=2)
 parser.add_argument("--machine", help="Machine type/configuration", default="[CORES:RV64GC]")
 parser.add_argument("--args", help="Command line arguments to pass to the target executable", default="")
 parser.add_argument("--startSymbol", help="ELF Symbol Rev should begin execution at", default="[0:main]")
+parser.add_argument("--enableVFS", type=int, choices=[0, 1], help="Serve guest file I/O from the in-memory filesystem", default=0)
+parser.add_argument("--recordLog", help="Record host syscall results and random draws to this file", default="")
+parser.add_argument("--replayLog", help="Replay host syscall results and random draws from this file", default="")
+parser.add_argument("--threadAffinity", help="CPU mask of the Nth thread created (CPU = core*numHarts+hart), THREADS for the rest", default="[]")
 
 # Parse arguments
 args = parser.parse_args()
@@ -54,7 +58,11 @@ comp_cpu.addParams({
     "program" : args.program,
     "startAddr" : "[0:0x00000000]",
     "startSymbol" : args.startSymbol,
+    "threadAffinity" : args.threadAffinity,
     "enable_memH" : args.enableMemH,
+    "enableVFS" : args.enableVFS,
+    "recordLog" : args.recordLog,
+    "replayLog" : args.replayLog,
     "args": args.args,
     "splash" : 1
 })
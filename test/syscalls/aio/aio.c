@@ -0,0 +1,102 @@
+/*
+ * aio.c
+ *
+ * RISC-V ISA: RV64GC
+ *
+ * Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ * Linux AIO on a host file: a PWRITE and a PREAD round trip through
+ * io_submit/io_getevents, a submission larger than the context is cut
+ * down to its capacity, and descriptors in the VFS range are rejected.
+ */
+
+#include "../../../common/syscalls/syscalls.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+
+#define assert(x)                                                              \
+  do                                                                           \
+    if (!(x)) {                                                                \
+      asm(".dword 0x00000000");                                                \
+    }                                                                          \
+  while (0)
+
+#define CAPACITY 2
+#define LEN 32
+
+// RevVFS hands out descriptors from 1 << 24 upwards
+#define VFS_FIRST_FD (1 << 24)
+
+static void prep(struct iocb *cb, uint64_t data, uint16_t opcode, int fd,
+                 void *buf, uint64_t nbytes, int64_t offset) {
+  char *p = (char *)cb;
+  for (unsigned i = 0; i < sizeof(*cb); i++)
+    p[i] = 0;
+  cb->aio_data = data;
+  cb->aio_lio_opcode = opcode;
+  cb->aio_fildes = fd;
+  cb->aio_buf = (uint64_t)(uintptr_t)buf;
+  cb->aio_nbytes = nbytes;
+  cb->aio_offset = offset;
+}
+
+int main(int argc, char **argv) {
+  const char path[] = "aio.tmp";
+  char out[LEN];
+  char in[LEN];
+  for (int i = 0; i < LEN; i++) {
+    out[i] = 'a' + i % 26;
+    in[i] = 0;
+  }
+
+  aio_context_t ctx = 0;
+  assert(rev_io_setup(CAPACITY, &ctx) == 0);
+
+  int fd = rev_openat(AT_FDCWD, path, O_CREAT | O_TRUNC | O_RDWR, 0644);
+  assert(fd >= 0);
+
+  struct iocb cb[CAPACITY + 1];
+  struct iocb *cbs[CAPACITY + 1];
+  struct io_event ev[CAPACITY];
+  for (int i = 0; i <= CAPACITY; i++)
+    cbs[i] = &cb[i];
+
+  // write, then read back what was written
+  prep(&cb[0], 1, IOCB_CMD_PWRITE, fd, out, LEN, 0);
+  assert(rev_io_submit(ctx, 1, cbs) == 1);
+  assert(rev_io_getevents(ctx, 1, CAPACITY, ev, NULL) == 1);
+  assert(ev[0].data == 1);
+  assert(ev[0].obj == (uint64_t)(uintptr_t)&cb[0]);
+  assert(ev[0].res == LEN);
+
+  prep(&cb[0], 2, IOCB_CMD_PREAD, fd, in, LEN, 0);
+  assert(rev_io_submit(ctx, 1, cbs) == 1);
+  assert(rev_io_getevents(ctx, 1, CAPACITY, ev, NULL) == 1);
+  assert(ev[0].data == 2);
+  assert(ev[0].res == LEN);
+  for (int i = 0; i < LEN; i++)
+    assert(in[i] == out[i]);
+
+  // only as many requests as the context holds are taken
+  for (int i = 0; i <= CAPACITY; i++)
+    prep(&cb[i], 10 + i, IOCB_CMD_NOOP, fd, NULL, 0, 0);
+  assert(rev_io_submit(ctx, CAPACITY + 1, cbs) == CAPACITY);
+  assert(rev_io_getevents(ctx, CAPACITY, CAPACITY, ev, NULL) == CAPACITY);
+
+  // VFS descriptors are not served by the host AIO path
+  prep(&cb[0], 3, IOCB_CMD_PREAD, VFS_FIRST_FD + 5, in, LEN, 0);
+  assert(rev_io_submit(ctx, 1, cbs) == -EBADF);
+
+  assert(rev_io_destroy(ctx) == 0);
+  assert(rev_close(fd) == 0);
+  assert(rev_unlinkat(AT_FDCWD, path, 0) == 0);
+
+  const char msg[] = "aio passed\n";
+  rev_write(STDOUT_FILENO, msg, sizeof(msg) - 1);
+  return 0;
+}
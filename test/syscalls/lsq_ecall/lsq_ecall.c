@@ -0,0 +1,75 @@
+/*
+ * lsq_ecall.c
+ *
+ * RISC-V ISA: RV64GC
+ *
+ * Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ * Loads that hit stores still in the load/store queue must see the stored
+ * data, whether it is forwarded (the load is covered by one store) or the
+ * load waits for the stores to drain (it spans several).  System calls read
+ * and write guest memory directly, so the queue has to drain before an
+ * ECALL: a write() must see the stores before it, and a load after a read()
+ * must see the data the kernel put there rather than an older store.
+ */
+
+#include "../../../common/syscalls/syscalls.h"
+#include <fcntl.h>
+#include <stdint.h>
+
+#define assert(x)                                                              \
+  do                                                                           \
+    if (!(x)) {                                                                \
+      asm(".dword 0x00000000");                                                \
+    }                                                                          \
+  while (0)
+
+#define LEN 16
+
+static volatile uint64_t word;
+static volatile uint8_t buf[LEN];
+
+int main(int argc, char **argv) {
+  // every narrower load is covered by the doubleword store
+  word = 0x1122334455667788ull;
+  assert(((volatile uint8_t *)&word)[0] == 0x88);
+  assert(((volatile uint16_t *)&word)[1] == 0x5566);
+  assert(((volatile uint32_t *)&word)[1] == 0x11223344);
+
+  // the doubleword load spans several byte stores
+  for (int i = 0; i < 8; i++)
+    ((volatile uint8_t *)&word)[i] = 0xa0 + i;
+  assert(word == 0xa7a6a5a4a3a2a1a0ull);
+
+  // the youngest store wins
+  ((volatile uint16_t *)&word)[0] = 0x1234;
+  ((volatile uint16_t *)&word)[0] = 0x5678;
+  assert(((volatile uint16_t *)&word)[0] == 0x5678);
+
+  const char path[] = "lsq_ecall.tmp";
+  int fd = rev_openat(AT_FDCWD, path, O_CREAT | O_TRUNC | O_RDWR, 0644);
+  assert(fd >= 0);
+
+  // write() sees the stores that precede it
+  for (int i = 0; i < LEN; i++)
+    buf[i] = 'A' + i;
+  assert(rev_write(fd, (const void *)buf, LEN) == LEN);
+
+  // loads after pread() see the file data, not the stores before it
+  for (int i = 0; i < LEN; i++)
+    buf[i] = 0;
+  assert(rev_pread64(fd, (void *)buf, LEN, 0) == LEN);
+  for (int i = 0; i < LEN; i++)
+    assert(buf[i] == 'A' + i);
+
+  assert(rev_close(fd) == 0);
+  assert(rev_unlinkat(AT_FDCWD, path, 0) == 0);
+
+  const char msg[] = "lsq ecall passed\n";
+  rev_write(STDOUT_FILENO, msg, sizeof(msg) - 1);
+  return 0;
+}
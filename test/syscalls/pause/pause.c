@@ -0,0 +1,49 @@
+/*
+ * pause.c
+ *
+ * RISC-V ISA: RV64GC
+ *
+ * Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ * The main thread ends by pausing, the way the C library implements
+ * pause() on RISC-V: ppoll with no descriptors and no timeout.  No signal
+ * ever arrives, so the simulation has to end normally instead of treating
+ * the paused thread as a deadlock.
+ */
+
+#include "../../../common/syscalls/syscalls.h"
+#include <stdint.h>
+
+#define assert(x)                                                              \
+  do                                                                           \
+    if (!(x)) {                                                                \
+      asm(".dword 0x00000000");                                                \
+    }                                                                          \
+  while (0)
+
+static int ran = 0;
+
+void *worker() {
+  __atomic_store_n(&ran, 1, __ATOMIC_RELEASE);
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  rev_pthread_t tid;
+  rev_pthread_create(&tid, NULL, (void *)worker, NULL);
+  rev_pthread_join(tid);
+  assert(ran == 1);
+
+  const char msg[] = "pausing\n";
+  rev_write(STDOUT_FILENO, msg, sizeof(msg) - 1);
+
+  rev_ppoll_time32(NULL, 0, NULL, NULL, 0);
+
+  // nothing wakes a paused thread
+  assert(0);
+  return 0;
+}
@@ -0,0 +1,95 @@
+/*
+ * replay.c
+ *
+ * RISC-V ISA: RV64GC
+ *
+ * Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ * Draws on three host inputs: the working directory, the contents of
+ * replay.txt and the ID of a new thread.  run_replay.sh records a run and
+ * replays it from another directory with different file contents, passing
+ * the recorded values in argv so the replay can check it saw them:
+ *
+ *   replay.exe <cwd> <file contents> <thread ID, or - when recording>
+ */
+
+#include "../../../common/syscalls/syscalls.h"
+#include <fcntl.h>
+#include <stdint.h>
+
+#define assert(x)                                                              \
+  do                                                                           \
+    if (!(x)) {                                                                \
+      asm(".dword 0x00000000");                                                \
+    }                                                                          \
+  while (0)
+
+static int same(const char *a, const char *b) {
+  while (*a && *a == *b) {
+    a++;
+    b++;
+  }
+  return *a == *b;
+}
+
+static int length(const char *s) {
+  int n = 0;
+  while (s[n])
+    n++;
+  return n;
+}
+
+static uint64_t parse(const char *s) {
+  uint64_t v = 0;
+  while (*s >= '0' && *s <= '9')
+    v = v * 10 + (*s++ - '0');
+  return v;
+}
+
+static void print_tid(uint64_t tid) {
+  char buf[32] = "tid ";
+  char digits[24];
+  int n = 0;
+  do {
+    digits[n++] = '0' + tid % 10;
+    tid /= 10;
+  } while (tid);
+  int len = 4;
+  while (n)
+    buf[len++] = digits[--n];
+  buf[len++] = '\n';
+  rev_write(STDOUT_FILENO, buf, len);
+}
+
+void *worker() { return 0; }
+
+int main(int argc, char **argv) {
+  assert(argc == 4);
+
+  char cwd[256];
+  assert(rev_getcwd(cwd, sizeof(cwd)) != 0);
+  assert(same(cwd, argv[1]));
+
+  char buf[64];
+  int fd = rev_openat(AT_FDCWD, "replay.txt", O_RDONLY, 0);
+  assert(fd >= 0);
+  int n = rev_read(fd, buf, sizeof(buf) - 1);
+  assert(n == length(argv[2]));
+  buf[n] = '\0';
+  assert(same(buf, argv[2]));
+  rev_close(fd);
+
+  rev_pthread_t tid;
+  rev_pthread_create(&tid, NULL, (void *)worker, NULL);
+  rev_pthread_join(tid);
+  if (same(argv[3], "-"))
+    print_tid(tid);
+  else
+    assert(tid == parse(argv[3]));
+
+  return 0;
+}
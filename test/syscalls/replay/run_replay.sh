@@ -0,0 +1,40 @@
+#!/bin/bash
+
+#Build the test
+make clean && make
+rm -rf replay.dir replay.log replay.txt
+
+# Check that the exec was built...
+if [ ! -x replay.exe ]; then
+	echo "Test REPLAY: replay.exe not Found - likely build failed"
+	exit 1
+fi
+
+CONFIG=$(pwd)/../../rev-model-options-config.py
+LIBS=$(pwd)/../../../build/src/
+CWD=$(pwd)
+
+# Record a run
+printf "recorded" > replay.txt
+out=$(sst --add-lib-path=$LIBS $CONFIG -- --program="replay.exe" --recordLog=replay.log --args "$CWD recorded -" 2>&1)
+if ! echo "$out" | grep -q "Simulation is complete"; then
+	echo "$out"
+	echo "Test REPLAY: the recording run failed"
+	exit 1
+fi
+tid=$(echo "$out" | sed -n 's/^tid \([0-9]*\)$/\1/p')
+if [ -z "$tid" ]; then
+	echo "Test REPLAY: the recording run did not report its thread ID"
+	exit 1
+fi
+
+# Replay it somewhere else, with the input file changed; the guest must
+# still see the recorded directory, file contents and thread ID
+mkdir replay.dir
+printf "replayed" > replay.dir/replay.txt
+cd replay.dir
+sst --add-lib-path=$LIBS $CONFIG -- --program="../replay.exe" --replayLog=../replay.log --args "$CWD recorded $tid"
+rc=$?
+cd ..
+rm -rf replay.dir replay.log replay.txt
+exit $rc
@@ -0,0 +1,25 @@
+#!/bin/bash
+
+#Build the test
+make clean && make
+rm -rf vfs.dir
+
+# Check that the exec was built...
+if [ ! -x vfs.exe ]; then
+	echo "Test VFS: vfs.exe not Found - likely build failed"
+	exit 1
+fi
+
+# ctest passes on the completion message, so only show it once the host
+# filesystem has been checked
+out=$(sst --add-lib-path=../../../build/src/ ../../rev-model-options-config.py -- --program="vfs.exe" --enableVFS=1 2>&1)
+rc=$?
+
+# the guest's files live only in the in-memory filesystem
+if [ -e vfs.dir ]; then
+	echo "Test VFS: vfs.dir was created on the host"
+	exit 1
+fi
+
+echo "$out"
+exit $rc
@@ -0,0 +1,86 @@
+/*
+ * vfs.c
+ *
+ * RISC-V ISA: RV64GC
+ *
+ * Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ * File I/O against the in-memory filesystem (enableVFS=1): create a
+ * directory and a file in it, write, seek, read back, reopen, and unlink
+ * both.  run_vfs.sh checks that nothing reached the host filesystem.
+ */
+
+#include "../../../common/syscalls/syscalls.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#define assert(x)                                                              \
+  do                                                                           \
+    if (!(x)) {                                                                \
+      asm(".dword 0x00000000");                                                \
+    }                                                                          \
+  while (0)
+
+// RevVFS hands out descriptors from 1 << 24 upwards
+#define VFS_FIRST_FD (1 << 24)
+
+// on RV64 ECALL 62 is lseek(fd, offset, whence)
+static int seek(int fd, long offset, int whence) {
+  return rev_llseek(fd, offset, whence, NULL, 0);
+}
+
+int main(int argc, char **argv) {
+  const char dir[] = "vfs.dir";
+  const char path[] = "vfs.dir/vfs.tmp";
+  const char text[] = "abcdefghijklmnopqrstuvwxyz";
+  const int len = sizeof(text) - 1;
+  char buf[32];
+
+  // nothing exists until the guest creates it
+  assert(rev_openat(AT_FDCWD, path, O_RDONLY, 0) == -ENOENT);
+
+  assert(rev_mkdirat(AT_FDCWD, dir, 0755) == 0);
+  int fd = rev_openat(AT_FDCWD, path, O_CREAT | O_TRUNC | O_RDWR, 0644);
+  assert(fd >= VFS_FIRST_FD);
+
+  assert(rev_write(fd, text, len) == len);
+  assert(seek(fd, 0, SEEK_END) == len);
+
+  // read from the middle of the file
+  assert(seek(fd, 10, SEEK_SET) == 10);
+  assert(rev_read(fd, buf, 5) == 5);
+  for (int i = 0; i < 5; i++)
+    assert(buf[i] == text[10 + i]);
+
+  // reading at the end returns nothing
+  assert(seek(fd, 0, SEEK_END) == len);
+  assert(rev_read(fd, buf, sizeof(buf)) == 0);
+
+  // pread does not move the file offset
+  assert(rev_pread64(fd, buf, 3, 23) == 3);
+  assert(buf[0] == 'x' && buf[1] == 'y' && buf[2] == 'z');
+  assert(seek(fd, 0, SEEK_CUR) == len);
+  assert(rev_close(fd) == 0);
+
+  // the contents outlive the descriptor
+  fd = rev_openat(AT_FDCWD, path, O_RDONLY, 0);
+  assert(fd >= VFS_FIRST_FD);
+  assert(rev_read(fd, buf, sizeof(buf)) == len);
+  for (int i = 0; i < len; i++)
+    assert(buf[i] == text[i]);
+  assert(rev_close(fd) == 0);
+
+  assert(rev_unlinkat(AT_FDCWD, path, 0) == 0);
+  assert(rev_openat(AT_FDCWD, path, O_RDONLY, 0) == -ENOENT);
+  assert(rev_unlinkat(AT_FDCWD, dir, AT_REMOVEDIR) == 0);
+
+  const char msg[] = "vfs passed\n";
+  rev_write(STDOUT_FILENO, msg, sizeof(msg) - 1);
+  return 0;
+}
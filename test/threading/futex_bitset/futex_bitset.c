@@ -0,0 +1,90 @@
+/*
+ * futex_bitset.c
+ *
+ * RISC-V ISA: RV64GC
+ *
+ * Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ * Two threads wait on the same futex word with disjoint bitsets.  A
+ * FUTEX_WAKE_BITSET must only wake the waiter whose bitset it intersects.
+ */
+
+#include "../../../common/syscalls/syscalls.h"
+#include <errno.h>
+#include <stdint.h>
+
+#define assert(x)                                                              \
+  do                                                                           \
+    if (!(x)) {                                                                \
+      asm(".dword 0x00000000");                                                \
+    }                                                                          \
+  while (0)
+
+#define FUTEX_WAIT_BITSET 9
+#define FUTEX_WAKE_BITSET 10
+
+#define ALL 0x7fffffff
+
+static uint32_t word = 0;
+static int done[2] = {0, 0};
+static int result[2] = {1, 1};
+
+// the word never changes, so the wait only ends when the thread is woken
+static void wait_bitset(int i) {
+  result[i] = rev_futex(&word, FUTEX_WAIT_BITSET, 0, NULL, NULL, 1u << i);
+  __atomic_store_n(&done[i], 1, __ATOMIC_RELEASE);
+}
+
+void *waiter0() {
+  wait_bitset(0);
+  return 0;
+}
+
+void *waiter1() {
+  wait_bitset(1);
+  return 0;
+}
+
+static int wake_bitset(uint32_t bitset) {
+  return rev_futex(&word, FUTEX_WAKE_BITSET, ALL, NULL, NULL, bitset);
+}
+
+int main(int argc, char **argv) {
+  // an empty bitset is rejected
+  assert(rev_futex(&word, FUTEX_WAIT_BITSET, 0, NULL, NULL, 0) == -EINVAL);
+  assert(wake_bitset(0) == -EINVAL);
+
+  rev_pthread_t tid0, tid1;
+  rev_pthread_create(&tid0, NULL, (void *)waiter0, NULL);
+  rev_pthread_create(&tid1, NULL, (void *)waiter1, NULL);
+
+  // wake waiter 1 once it has blocked; waiter 0 must stay put
+  int woken = 0;
+  while (!__atomic_load_n(&done[1], __ATOMIC_ACQUIRE)) {
+    woken += wake_bitset(0x2);
+    rev_sched_yield();
+  }
+  assert(woken == 1);
+  assert(result[1] == 0);
+  assert(wake_bitset(0x2) == 0);
+  assert(!__atomic_load_n(&done[0], __ATOMIC_ACQUIRE));
+
+  woken = 0;
+  while (!__atomic_load_n(&done[0], __ATOMIC_ACQUIRE)) {
+    woken += wake_bitset(0x1);
+    rev_sched_yield();
+  }
+  assert(woken == 1);
+  assert(result[0] == 0);
+
+  rev_pthread_join(tid0);
+  rev_pthread_join(tid1);
+
+  const char msg[] = "futex bitset passed\n";
+  rev_write(STDOUT_FILENO, msg, sizeof(msg) - 1);
+  return 0;
+}
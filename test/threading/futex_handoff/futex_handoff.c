@@ -0,0 +1,78 @@
+/*
+ * futex_handoff.c
+ *
+ * RISC-V ISA: RV64GC
+ *
+ * Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ * Two threads pass a token back and forth, each blocking in FUTEX_WAIT
+ * until the other one hands it over with FUTEX_WAKE
+ */
+
+#include "../../../common/syscalls/syscalls.h"
+#include <errno.h>
+#include <stdint.h>
+
+#define assert(x)                                                              \
+  do                                                                           \
+    if (!(x)) {                                                                \
+      asm(".dword 0x00000000");                                                \
+    }                                                                          \
+  while (0)
+
+#define FUTEX_WAIT 0
+#define FUTEX_WAKE 1
+#define FUTEX_PRIVATE_FLAG 128
+
+#define ROUNDS 8
+
+static uint32_t turn = 0; // 0: main thread, 1: worker
+static int count = 0;
+
+static void wait_for(uint32_t want) {
+  uint32_t cur;
+  while ((cur = __atomic_load_n(&turn, __ATOMIC_ACQUIRE)) != want)
+    rev_futex(&turn, FUTEX_WAIT | FUTEX_PRIVATE_FLAG, cur, NULL, NULL, 0);
+}
+
+static void pass_to(uint32_t next) {
+  __atomic_store_n(&turn, next, __ATOMIC_RELEASE);
+  rev_futex(&turn, FUTEX_WAKE | FUTEX_PRIVATE_FLAG, 1, NULL, NULL, 0);
+}
+
+void *worker() {
+  for (int i = 0; i < ROUNDS; i++) {
+    wait_for(1);
+    assert(count == 2 * i + 1);
+    count++;
+    pass_to(0);
+  }
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  // a stale expected value does not block
+  assert(rev_futex(&turn, FUTEX_WAIT, 1, NULL, NULL, 0) == -EAGAIN);
+  // nobody is waiting yet
+  assert(rev_futex(&turn, FUTEX_WAKE, 1, NULL, NULL, 0) == 0);
+
+  rev_pthread_t tid;
+  rev_pthread_create(&tid, NULL, (void *)worker, NULL);
+
+  for (int i = 0; i < ROUNDS; i++) {
+    assert(count == 2 * i);
+    count++;
+    pass_to(1);
+    wait_for(0);
+  }
+  rev_pthread_join(tid);
+  assert(count == 2 * ROUNDS);
+
+  const char msg[] = "futex handoff passed\n";
+  rev_write(STDOUT_FILENO, msg, sizeof(msg) - 1);
+  return 0;
+}
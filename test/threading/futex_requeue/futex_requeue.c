@@ -0,0 +1,82 @@
+/*
+ * futex_requeue.c
+ *
+ * RISC-V ISA: RV64GC
+ *
+ * Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ * Waiters block on a gate futex.  The main thread moves every one of them
+ * onto a second futex with FUTEX_CMP_REQUEUE, checks that none is left on
+ * the gate, then opens the gate and wakes them all from the second futex
+ */
+
+#include "../../../common/syscalls/syscalls.h"
+#include <errno.h>
+#include <stdint.h>
+
+#define assert(x)                                                              \
+  do                                                                           \
+    if (!(x)) {                                                                \
+      asm(".dword 0x00000000");                                                \
+    }                                                                          \
+  while (0)
+
+#define FUTEX_WAIT 0
+#define FUTEX_WAKE 1
+#define FUTEX_CMP_REQUEUE 4
+
+#define WAITERS 3
+#define ALL 0x7fffffff
+
+static uint32_t gate = 0;
+static uint32_t lock = 0;
+static int passed = 0;
+
+void *waiter() {
+  while (!__atomic_load_n(&gate, __ATOMIC_ACQUIRE))
+    rev_futex(&gate, FUTEX_WAIT, 0, NULL, NULL, 0);
+  __atomic_fetch_add(&passed, 1, __ATOMIC_RELAXED);
+  return 0;
+}
+
+// CMP_REQUEUE takes the requeue count in place of the timeout
+static int requeue(uint32_t expected) {
+  return rev_futex(&gate, FUTEX_CMP_REQUEUE, 0,
+                   (struct __kernel_timespec *)(uintptr_t)ALL, &lock, expected);
+}
+
+int main(int argc, char **argv) {
+  rev_pthread_t tid[WAITERS];
+  for (int i = 0; i < WAITERS; i++)
+    rev_pthread_create(&tid[i], NULL, (void *)waiter, NULL);
+
+  // the gate no longer holds the expected value
+  assert(requeue(1) == -EAGAIN);
+
+  // collect the waiters on lock as they block on the gate
+  int moved = 0;
+  while (moved < WAITERS) {
+    int rc = requeue(0);
+    assert(rc >= 0);
+    moved += rc;
+    rev_sched_yield();
+  }
+  assert(moved == WAITERS);
+  assert(rev_futex(&gate, FUTEX_WAKE, ALL, NULL, NULL, 0) == 0);
+  assert(passed == 0);
+
+  __atomic_store_n(&gate, 1, __ATOMIC_RELEASE);
+  assert(rev_futex(&lock, FUTEX_WAKE, ALL, NULL, NULL, 0) == WAITERS);
+
+  for (int i = 0; i < WAITERS; i++)
+    rev_pthread_join(tid[i]);
+  assert(passed == WAITERS);
+
+  const char msg[] = "futex requeue passed\n";
+  rev_write(STDOUT_FILENO, msg, sizeof(msg) - 1);
+  return 0;
+}
@@ -0,0 +1,67 @@
+/*
+ * preempt.c
+ *
+ * RISC-V ISA: RV64GC
+ *
+ * Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ * Three threads on a single hart pass a token around a ring, each one
+ * spinning without a system call until it is its turn.  The spinning
+ * thread only gives up the hart when its time slice runs out, so the
+ * program only finishes if the threads are preempted.
+ */
+
+#include "../../../common/syscalls/syscalls.h"
+#include <stdint.h>
+
+#define assert(x)                                                              \
+  do                                                                           \
+    if (!(x)) {                                                                \
+      asm(".dword 0x00000000");                                                \
+    }                                                                          \
+  while (0)
+
+#define THREADS 3
+#define ROUNDS 4
+
+static uint64_t turn = 0; // owner of the token is turn % THREADS
+static uint64_t visits[THREADS];
+
+static void ring(uint64_t me) {
+  for (int i = 0; i < ROUNDS; i++) {
+    while (__atomic_load_n(&turn, __ATOMIC_ACQUIRE) % THREADS != me)
+      ;
+    visits[me]++;
+    __atomic_store_n(&turn, turn + 1, __ATOMIC_RELEASE);
+  }
+}
+
+void *worker(uint64_t *me) {
+  ring(*me);
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  uint64_t ids[THREADS];
+  rev_pthread_t tid[THREADS];
+  for (uint64_t i = 1; i < THREADS; i++) {
+    ids[i] = i;
+    assert(rev_pthread_create(&tid[i], NULL, (void *)worker, &ids[i]) == 0);
+  }
+
+  ring(0);
+  for (int i = 1; i < THREADS; i++)
+    rev_pthread_join(tid[i]);
+
+  assert(turn == THREADS * ROUNDS);
+  for (int i = 0; i < THREADS; i++)
+    assert(visits[i] == ROUNDS);
+
+  const char msg[] = "preempt passed\n";
+  rev_write(STDOUT_FILENO, msg, sizeof(msg) - 1);
+  return 0;
+}
@@ -0,0 +1,33 @@
+#
+# Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+# All Rights Reserved
+# contact@tactcomplabs.com
+#
+# See LICENSE in the top level directory for licensing details
+#
+# rev-test-preempt.py
+#
+# One core with one hart and a time slice; verbose 3 prints the
+# preemption statistics
+#
+
+import sst
+
+# Define the simulation components
+comp_cpu = sst.Component("cpu", "revcpu.RevCPU")
+comp_cpu.addParams({
+        "verbose" : 3,                                # Verbosity; 3 prints the core statistics
+        "numCores" : 1,                               # Number of cores
+        "numHarts" : 1,                               # Harts per core
+        "clock" : "2.0GHz",                           # Clock
+        "memSize" : 1024*1024*1024-1,                 # Memory size in bytes
+        "machine" : "[CORES:RV64GC]",                 # Core:Config; RV64GC for all
+        "startAddr" : "[CORES:0x00000000]",           # Starting address for all cores
+        "memCost" : "[0:1:10]",                       # Memory loads required 1-10 cycles
+        "program" : "preempt.exe",                    # Target executable
+        "timeSlice" : 2000,                           # Cycles before a waiting thread preempts
+        "contextSwitchCost" : 100,                    # Cycles a hart stalls after a preemption
+        "splash" : 0                                  # Display the splash message
+})
+
+# EOF
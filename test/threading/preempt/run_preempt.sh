@@ -0,0 +1,34 @@
+#!/bin/bash
+
+#Build the test
+make clean && make
+
+# Check that the exec was built...
+if [ ! -x preempt.exe ]; then
+	echo "Test PREEMPT: preempt.exe not Found - likely build failed"
+	exit 1
+fi
+
+out=$(sst --add-lib-path=../../../build/src/ ./rev-test-preempt.py 2>&1)
+if ! echo "$out" | grep -q "preempt passed"; then
+	echo "$out"
+	echo "Test PREEMPT: the threads did not finish"
+	exit 1
+fi
+
+# 9 of the 11 handoffs of the token take a preemption (the other two
+# follow a thread finishing its rounds), and each one stalls the hart for
+# at least contextSwitchCost cycles
+read -r preemptions cycles <<< "$(echo "$out" | sed -n 's/.*Preemptions: \([0-9]*\) Context Switch Cycles: \([0-9]*\).*/\1 \2/p' | head -1)"
+if [ -z "$preemptions" ] || [ "$preemptions" -lt 9 ]; then
+	echo "$out"
+	echo "Test PREEMPT: expected at least 9 preemptions, saw ${preemptions:-none}"
+	exit 1
+fi
+if [ "$cycles" -lt $((preemptions * 100)) ]; then
+	echo "$out"
+	echo "Test PREEMPT: $preemptions preemptions cost only $cycles context switch cycles"
+	exit 1
+fi
+
+echo "$out"
@@ -0,0 +1,76 @@
+/*
+ * pthread_native.c
+ *
+ * RISC-V ISA: RV64GC
+ *
+ * Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ * pthread_create/pthread_join from the toolchain libc, which go through
+ * clone/clone3 with CLONE_SETTLS, CLONE_CHILD_SETTID/PARENT_SETTID and
+ * CLONE_CHILD_CLEARTID.  A thread that ends with pthread_exit only ends
+ * itself, and joining relies on the kernel clearing the child tid and
+ * waking the futex on it.
+ */
+
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#define assert(x)                                                              \
+  do                                                                           \
+    if (!(x)) {                                                                \
+      asm(".dword 0x00000000");                                                \
+    }                                                                          \
+  while (0)
+
+#define NTHREADS 4
+
+// every thread starts with its own copy of the TLS image
+static __thread int tls_value = 7;
+static int results[NTHREADS];
+
+void *body(void *arg) {
+  int i = (int)(intptr_t)arg;
+  assert(tls_value == 7);
+  tls_value = 100 + i;
+  results[i] = tls_value;
+  return (void *)(intptr_t)(i + 1);
+}
+
+void *exits_early(void *arg) {
+  pthread_exit((void *)(intptr_t)42);
+  // not reached
+  assert(0);
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  pthread_t tid[NTHREADS];
+  for (int i = 0; i < NTHREADS; i++)
+    assert(pthread_create(&tid[i], NULL, body, (void *)(intptr_t)i) == 0);
+
+  for (int i = 0; i < NTHREADS; i++) {
+    void *ret = NULL;
+    assert(pthread_join(tid[i], &ret) == 0);
+    assert((intptr_t)ret == i + 1);
+    assert(results[i] == 100 + i);
+  }
+  // the threads wrote their own copies
+  assert(tls_value == 7);
+
+  // pthread_exit ends the thread, not the program
+  pthread_t early;
+  void *ret = NULL;
+  assert(pthread_create(&early, NULL, exits_early, NULL) == 0);
+  assert(pthread_join(early, &ret) == 0);
+  assert((intptr_t)ret == 42);
+
+  const char msg[] = "native pthreads passed\n";
+  write(STDOUT_FILENO, msg, strlen(msg));
+  return 0;
+}
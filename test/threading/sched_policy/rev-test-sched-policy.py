@@ -0,0 +1,36 @@
+#
+# Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+# All Rights Reserved
+# contact@tactcomplabs.com
+#
+# See LICENSE in the top level directory for licensing details
+#
+# rev-test-sched-policy.py
+#
+# SCHED_CASE: roundrobin, fill or spread on 2 cores with 2 harts, or
+# steal on 2 cores with 1 hart
+#
+
+import os
+import sst
+
+case = os.getenv("SCHED_CASE", "roundrobin")
+
+# Define the simulation components
+comp_cpu = sst.Component("cpu", "revcpu.RevCPU")
+comp_cpu.addParams({
+        "verbose" : 2,                                # Verbosity
+        "numCores" : 2,                               # Number of cores
+        "numHarts" : 1 if case == "steal" else 2,     # Harts per core
+        "clock" : "2.0GHz",                           # Clock
+        "memSize" : 1024*1024*1024-1,                 # Memory size in bytes
+        "machine" : "[CORES:RV64GC]",                 # Core:Config; RV64GC for all
+        "startAddr" : "[CORES:0x00000000]",           # Starting address for all cores
+        "memCost" : "[0:1:10]",                       # Memory loads required 1-10 cycles
+        "program" : "sched_policy.exe",               # Target executable
+        "args" : case,                                # Case checked by the program
+        "schedPolicy" : "roundrobin" if case == "steal" else case,  # Thread placement
+        "splash" : 0                                  # Display the splash message
+})
+
+# EOF
@@ -0,0 +1,21 @@
+#!/bin/bash
+
+#Build the test
+make clean && make
+
+# Check that the exec was built...
+if [ ! -x sched_policy.exe ]; then
+	echo "Test SCHED_POLICY: sched_policy.exe not Found - likely build failed"
+	exit 1
+fi
+
+for case in roundrobin fill spread steal; do
+	out=$(SCHED_CASE=$case sst --add-lib-path=../../../build/src/ ./rev-test-sched-policy.py 2>&1)
+	if ! echo "$out" | grep -q "sched policy passed"; then
+		echo "$out"
+		echo "Test SCHED_POLICY: $case failed"
+		exit 1
+	fi
+done
+
+echo "$out"
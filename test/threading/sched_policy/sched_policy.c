@@ -0,0 +1,109 @@
+/*
+ * sched_policy.c
+ *
+ * RISC-V ISA: RV64GC
+ *
+ * Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ * Checks the core each thread is placed on.  argv[1] names the case:
+ *
+ *   roundrobin, fill, spread: 2 cores with 2 harts; three workers stay
+ *     busy until all of them are placed and report their core
+ *   steal: 2 cores with 1 hart, roundrobin; the second worker is queued
+ *     behind the spinning main thread on core 0 and only runs once the
+ *     idle core 1 steals it
+ */
+
+#include "../../../common/syscalls/syscalls.h"
+#include <stdint.h>
+
+#define assert(x)                                                              \
+  do                                                                           \
+    if (!(x)) {                                                                \
+      asm(".dword 0x00000000");                                                \
+    }                                                                          \
+  while (0)
+
+#define WORKERS 3
+
+static uint64_t release = 0;
+static uint64_t started = 0;
+static unsigned cores[WORKERS];
+
+static unsigned core(unsigned harts) {
+  unsigned cpu = ~0u;
+  assert(rev_getcpu(&cpu, NULL, NULL) == 0);
+  return cpu / harts;
+}
+
+static int same(const char *a, const char *b) {
+  while (*a && *a == *b) {
+    a++;
+    b++;
+  }
+  return *a == *b;
+}
+
+void *placed(uint64_t *me) {
+  cores[*me] = core(2);
+  __atomic_add_fetch(&started, 1, __ATOMIC_RELEASE);
+  while (!__atomic_load_n(&release, __ATOMIC_ACQUIRE))
+    ;
+  return 0;
+}
+
+void *stolen(uint64_t *me) {
+  cores[*me] = core(1);
+  __atomic_add_fetch(&started, 1, __ATOMIC_RELEASE);
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  assert(argc == 2);
+  uint64_t ids[WORKERS];
+  rev_pthread_t tid[WORKERS];
+
+  if (same(argv[1], "steal")) {
+    assert(core(1) == 0);
+    // roundrobin: the first worker goes to core 1, the second to core 0
+    for (uint64_t i = 0; i < 2; i++) {
+      ids[i] = i;
+      assert(rev_pthread_create(&tid[i], NULL, (void *)stolen, &ids[i]) == 0);
+    }
+    // never gives up core 0
+    while (__atomic_load_n(&started, __ATOMIC_ACQUIRE) != 2)
+      ;
+    for (int i = 0; i < 2; i++)
+      rev_pthread_join(tid[i]);
+    assert(cores[0] == 1 && cores[1] == 1);
+  } else {
+    assert(core(2) == 0);
+    for (uint64_t i = 0; i < WORKERS; i++) {
+      ids[i] = i;
+      assert(rev_pthread_create(&tid[i], NULL, (void *)placed, &ids[i]) == 0);
+    }
+    while (__atomic_load_n(&started, __ATOMIC_ACQUIRE) != WORKERS)
+      ;
+    __atomic_store_n(&release, 1, __ATOMIC_RELEASE);
+    for (int i = 0; i < WORKERS; i++)
+      rev_pthread_join(tid[i]);
+
+    // main is on core 0
+    if (same(argv[1], "roundrobin")) // cycles through the cores
+      assert(cores[0] == 1 && cores[1] == 0 && cores[2] == 1);
+    else if (same(argv[1], "fill")) // fills core 0 first
+      assert(cores[0] == 0 && cores[1] == 1 && cores[2] == 1);
+    else if (same(argv[1], "spread")) // least loaded core
+      assert(cores[0] == 1 && cores[1] == 0 && cores[2] == 1);
+    else
+      assert(0);
+  }
+
+  const char msg[] = "sched policy passed\n";
+  rev_write(STDOUT_FILENO, msg, sizeof(msg) - 1);
+  return 0;
+}
@@ -0,0 +1,38 @@
+#
+# Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+# All Rights Reserved
+# contact@tactcomplabs.com
+#
+# See LICENSE in the top level directory for licensing details
+#
+# rev-test-trace-async.py
+#
+# TRC_FULL unset:        text trace rendered inline
+# TRC_FULL=block|drop:   text trace rendered by the writer thread through
+#                        a queue of TRC_QUEUE records
+#
+
+import os
+import sst
+
+trc_full = os.getenv("TRC_FULL", "")
+
+# Define the simulation components
+comp_cpu = sst.Component("cpu", "revcpu.RevCPU")
+comp_cpu.addParams({
+        "verbose" : 5,                                # Verbosity; 5 renders the text trace
+        "numCores" : 1,                               # Number of cores
+        "clock" : "2.0GHz",                           # Clock
+        "memSize" : 1024*1024*1024-1,                 # Memory size in bytes
+        "machine" : "[0:RV64GC]",                     # Core:Config; RV64GC for core 0
+        "startAddr" : "[0:0x00000000]",               # Starting address for core 0
+        "memCost" : "[0:1:10]",                       # Memory loads required 1-10 cycles
+        "program" : os.getenv("REV_EXE", "trace_async.exe"),  # Target executable
+        "trcStartCycle" : 1,                          # Trace from the first cycle
+        "trcAsync" : 1 if trc_full else 0,            # Render on the writer thread
+        "trcFull" : trc_full or "block",              # Wait or drop when the queue is full
+        "trcQueue" : int(os.getenv("TRC_QUEUE", "65536")),  # Writer queue depth
+        "splash" : 0                                  # Display the splash message
+})
+
+# EOF
@@ -0,0 +1,54 @@
+#!/bin/bash
+
+#Build the test
+make clean && make
+rm -f trace_async.sync trace_async.block trace_async.drop
+
+# Check that the exec was built...
+if [ ! -x trace_async.exe ]; then
+	echo "Test TRACE_ASYNC: trace_async.exe not Found - likely build failed"
+	exit 1
+fi
+
+# Trace lines without the prefix, which holds the time inline and the
+# cycle on the writer thread; thread IDs are random from run to run
+trace() {
+	sed -n 's/^RevCPU\[[^]]*\]: //p' | grep -E '; \*[IA] ' | sed -e 's/Thread [0-9]*;/Thread T;/' -e 's/[[:space:]]*$//'
+}
+
+run() {
+	local out
+	out=$(sst --add-lib-path=../../build/src/ ./rev-test-trace-async.py 2>&1)
+	echo "$out" | grep -q "Simulation is complete" || { echo "$out"; exit 1; }
+	echo "$out" | trace
+}
+
+run > trace_async.sync
+TRC_FULL=block TRC_QUEUE=4 run > trace_async.block
+TRC_FULL=drop TRC_QUEUE=4 run > trace_async.drop
+
+if [ ! -s trace_async.sync ]; then
+	echo "Test TRACE_ASYNC: the inline trace is empty"
+	exit 1
+fi
+
+# block: nothing is lost
+if ! diff trace_async.sync trace_async.block; then
+	echo "Test TRACE_ASYNC: trcFull=block differs from the inline trace"
+	exit 1
+fi
+
+# drop: whatever is printed is the inline trace with lines left out
+if ! python3 - trace_async.sync trace_async.drop <<'PY'
+import sys
+full = open(sys.argv[1]).read().splitlines()
+it = iter(full)
+sys.exit(0 if all(line in it for line in open(sys.argv[2]).read().splitlines()) else 1)
+PY
+then
+	echo "Test TRACE_ASYNC: trcFull=drop is not a subsequence of the inline trace"
+	exit 1
+fi
+
+rm -f trace_async.sync trace_async.block trace_async.drop
+echo "Simulation is complete"
@@ -0,0 +1,49 @@
+/*
+ * trace_async.c
+ *
+ * RISC-V ISA: RV64GC
+ *
+ * Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * Enough loads, stores, branches and calls to fill a small trace queue.
+ * run_trace_async.sh traces it inline, then through the writer thread
+ * with trcFull=block and trcFull=drop, and compares the traces.
+ */
+
+#include <stdint.h>
+
+#define assert(x)                                                              \
+  do                                                                           \
+    if (!(x)) {                                                                \
+      asm(".dword 0x00000000");                                                \
+    }                                                                          \
+  while (0)
+
+#define N 64
+
+static uint64_t v[N];
+
+static uint64_t mix(uint64_t x) {
+  return (x << 7) ^ (x >> 3) ^ 0x9e3779b97f4a7c15ull;
+}
+
+int main(int argc, char **argv) {
+  for (int i = 0; i < N; i++)
+    v[i] = mix(i);
+  uint64_t s = 0;
+  for (int i = 0; i < N; i++)
+    if (v[i] & 1)
+      s += v[i];
+    else
+      s ^= v[i];
+  uint64_t t = 0;
+  for (int i = 0; i < N; i++)
+    if (mix(i) & 1)
+      t += mix(i);
+    else
+      t ^= mix(i);
+  assert(s == t);
+  return 0;
+}
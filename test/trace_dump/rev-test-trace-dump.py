@@ -0,0 +1,30 @@
+#
+# Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+# All Rights Reserved
+# contact@tactcomplabs.com
+#
+# See LICENSE in the top level directory for licensing details
+#
+# rev-test-trace-dump.py
+#
+# Flight recorder of 8 instructions and no text trace
+#
+
+import sst
+
+# Define the simulation components
+comp_cpu = sst.Component("cpu", "revcpu.RevCPU")
+comp_cpu.addParams({
+        "verbose" : 1,                                # Verbosity; the dumps print at any level
+        "numCores" : 1,                               # Number of cores
+        "clock" : "2.0GHz",                           # Clock
+        "memSize" : 1024*1024*1024-1,                 # Memory size in bytes
+        "machine" : "[0:RV64GC]",                     # Core:Config; RV64GC for core 0
+        "startAddr" : "[0:0x00000000]",               # Starting address for core 0
+        "memCost" : "[0:1:10]",                       # Memory loads required 1-10 cycles
+        "program" : "trace_dump.exe",                 # Target executable
+        "trcRing" : 8,                                # Instructions kept per hart
+        "splash" : 0                                  # Display the splash message
+})
+
+# EOF
@@ -0,0 +1,36 @@
+#!/bin/bash
+
+#Build the test
+make clean && make
+
+# Check that the exec was built...
+if [ ! -x trace_dump.exe ]; then
+	echo "Test TRACE_DUMP: trace_dump.exe not Found - likely build failed"
+	exit 1
+fi
+
+out=$(sst --add-lib-path=../../build/src/ ./rev-test-trace-dump.py 2>&1)
+echo "$out" | grep -q "Simulation is complete" || { echo "$out"; exit 1; }
+
+# "<instructions> <first cycle> <last cycle>" of each rev_trace_dump
+dumps=$(echo "$out" | awk '
+	/Flight recorder dump \(/ { dumping = /\(rev_trace_dump/; if (dumping) { if (n) print n, lo, hi; n = 0 } next }
+	dumping && /; \*F / { c = $0; sub(/.*; Cycle /, "", c); sub(/;.*/, "", c); if (!n || c < lo) lo = c; if (!n || c > hi) hi = c; n++ }
+	END { if (n) print n, lo, hi }')
+
+# the ring is full for the first two dumps; the third only holds the
+# few instructions between it and the second, and no dump repeats any
+# instruction of the one before
+if ! echo "$dumps" | awk '
+	{ n[NR] = $1; lo[NR] = $2; hi[NR] = $3 }
+	END {
+		if (NR != 3 || n[1] != 8 || n[2] != 8 || n[3] < 1 || n[3] >= 8) exit 1
+		for (i = 2; i <= NR; i++) if (lo[i] <= hi[i-1]) exit 1
+	}'; then
+	echo "$out"
+	echo "Test TRACE_DUMP: unexpected dumps (instructions, first and last cycle):"
+	echo "$dumps"
+	exit 1
+fi
+
+echo "$out"
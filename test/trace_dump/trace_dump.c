@@ -0,0 +1,42 @@
+/*
+ * trace_dump.c
+ *
+ * RISC-V ISA: RV64GC
+ *
+ * Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ * Dumps the trace flight recorder with rev_trace_dump (ECALL 502) after
+ * enough instructions to fill it, again after as many more, and once
+ * more right away.  run_trace_dump.sh checks that each dump only shows
+ * what ran since the one before.
+ */
+
+#include "../../common/syscalls/syscalls.h"
+#include <stdint.h>
+
+#define assert(x)                                                              \
+  do                                                                           \
+    if (!(x)) {                                                                \
+      asm(".dword 0x00000000");                                                \
+    }                                                                          \
+  while (0)
+
+static volatile uint64_t sink;
+
+static void work(int n) {
+  for (int i = 0; i < n; i++)
+    sink += i;
+}
+
+int main(int argc, char **argv) {
+  work(16);
+  assert(rev_trace_dump() == 0);
+  work(16);
+  assert(rev_trace_dump() == 0);
+  assert(rev_trace_dump() == 0);
+  return 0;
+}
@@ -0,0 +1,35 @@
+#
+# Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+# All Rights Reserved
+# contact@tactcomplabs.com
+#
+# See LICENSE in the top level directory for licensing details
+#
+# rev-test-trace-file.py
+#
+# TRC_FILE unset: text trace at verbose level 5
+# TRC_FILE set:   binary trace to <TRC_FILE>.0
+#
+
+import os
+import sst
+
+trc_file = os.getenv("TRC_FILE", "")
+
+# Define the simulation components
+comp_cpu = sst.Component("cpu", "revcpu.RevCPU")
+comp_cpu.addParams({
+        "verbose" : 2 if trc_file else 5,             # Verbosity; 5 renders the text trace
+        "numCores" : 1,                               # Number of cores
+        "clock" : "2.0GHz",                           # Clock
+        "memSize" : 1024*1024*1024-1,                 # Memory size in bytes
+        "machine" : "[0:RV64GC]",                     # Core:Config; RV64GC for core 0
+        "startAddr" : "[0:0x00000000]",               # Starting address for core 0
+        "memCost" : "[0:1:10]",                       # Memory loads required 1-10 cycles
+        "program" : os.getenv("REV_EXE", "trace_file.exe"),  # Target executable
+        "trcStartCycle" : 1,                          # Trace from the first cycle
+        "trcFile" : trc_file,                         # Binary trace file prefix
+        "splash" : 0                                  # Display the splash message
+})
+
+# EOF
@@ -0,0 +1,39 @@
+#!/bin/bash
+
+#Build the test
+make clean && make
+rm -f trace_file.bin.0 trace_file.text trace_file.decoded
+
+# Check that the exec was built...
+if [ ! -x trace_file.exe ]; then
+	echo "Test TRACE_FILE: trace_file.exe not Found - likely build failed"
+	exit 1
+fi
+
+# Thread IDs are random from run to run, and trailing blanks are not
+# significant
+normalize() {
+	sed -e 's/Thread [0-9]*;/Thread T;/' -e 's/[[:space:]]*$//'
+}
+
+# Text trace, without the SST logging prefix
+out=$(sst --add-lib-path=../../build/src/ ./rev-test-trace-file.py 2>&1)
+echo "$out" | grep -q "Simulation is complete" || { echo "$out"; exit 1; }
+echo "$out" | sed -n 's/^RevCPU\[[^]]*\]: //p' | grep -E '; \*[IA] ' | normalize > trace_file.text
+
+# Binary trace, decoded
+bin=$(TRC_FILE=trace_file.bin sst --add-lib-path=../../build/src/ ./rev-test-trace-file.py 2>&1)
+echo "$bin" | grep -q "Simulation is complete" || { echo "$bin"; exit 1; }
+python3 ../../scripts/revtrace.py trace_file.bin.0 | normalize > trace_file.decoded
+
+if [ ! -s trace_file.text ]; then
+	echo "Test TRACE_FILE: the text trace is empty"
+	exit 1
+fi
+if ! diff trace_file.text trace_file.decoded; then
+	echo "Test TRACE_FILE: revtrace.py output differs from the text trace"
+	exit 1
+fi
+
+rm -f trace_file.bin.0 trace_file.text trace_file.decoded
+echo "$bin"
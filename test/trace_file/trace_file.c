@@ -0,0 +1,56 @@
+/*
+ * trace_file.c
+ *
+ * RISC-V ISA: RV64GC
+ *
+ * Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ * A short program with loads, stores of several widths, branches and
+ * calls.  run_trace_file.sh traces it once as text and once to a binary
+ * trace file and checks that scripts/revtrace.py decodes the binary trace
+ * to the same text.
+ */
+
+#include <stdint.h>
+
+#define assert(x)                                                              \
+  do                                                                           \
+    if (!(x)) {                                                                \
+      asm(".dword 0x00000000");                                                \
+    }                                                                          \
+  while (0)
+
+#define N 8
+
+static uint64_t words[N];
+static uint32_t halves[N];
+static uint8_t bytes[N];
+
+static uint64_t sum(const uint64_t *v, int n) {
+  uint64_t s = 0;
+  for (int i = 0; i < n; i++)
+    s += v[i];
+  return s;
+}
+
+int main(int argc, char **argv) {
+  for (int i = 0; i < N; i++) {
+    words[i] = 0x0101010101010101ull * (i + 1);
+    halves[i] = 0x10001u * i;
+    bytes[i] = 0xf0 | i;
+  }
+  uint64_t s = sum(words, N);
+  assert(s == 0x0101010101010101ull * (N * (N + 1) / 2));
+  assert(halves[N - 1] == 0x70007u);
+  assert(bytes[3] == 0xf3);
+
+  double d = 0.5;
+  for (int i = 0; i < N; i++)
+    d *= 2.0;
+  assert(d == 128.0);
+  return 0;
+}
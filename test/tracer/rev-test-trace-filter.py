@@ -0,0 +1,43 @@
+#
+# Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+# All Rights Reserved
+# contact@tactcomplabs.com
+#
+# See LICENSE in the top level directory for licensing details
+#
+# rev-test-trace-filter.py
+#
+# Text trace of trace_filter.exe on two harts.  The trace filters are
+# taken from TRC_SYMBOLS, TRC_RANGE, TRC_HARTS, TRC_THREADS and TRC_CLASS,
+# and RECORD_LOG or REPLAY_LOG keep the thread IDs of the runs the same.
+#
+
+import os
+import sst
+
+params = {
+        "verbose" : 5,                                # Verbosity; 5 renders the text trace
+        "numCores" : 1,                               # Number of cores
+        "numHarts" : 2,                               # Harts per core
+        "clock" : "2.0GHz",                           # Clock
+        "memSize" : 1024*1024*1024-1,                 # Memory size in bytes
+        "machine" : "[CORES:RV64GC]",                 # Core:Config; RV64GC for all
+        "startAddr" : "[CORES:0x00000000]",           # Starting address for all cores
+        "memCost" : "[0:1:10]",                       # Memory loads required 1-10 cycles
+        "program" : "trace_filter.exe",               # Target executable
+        "trcStartCycle" : 1,                          # Trace from the first cycle
+        "recordLog" : os.getenv("RECORD_LOG", ""),    # Record the thread IDs
+        "replayLog" : os.getenv("REPLAY_LOG", ""),    # Replay the thread IDs
+        "splash" : 0                                  # Display the splash message
+}
+for param, env in (("trcSymbols", "TRC_SYMBOLS"), ("trcRange", "TRC_RANGE"),
+                   ("trcHarts", "TRC_HARTS"), ("trcThreads", "TRC_THREADS"),
+                   ("trcClass", "TRC_CLASS")):
+    if os.getenv(env):
+        params[param] = "[" + os.getenv(env) + "]"
+
+# Define the simulation components
+comp_cpu = sst.Component("cpu", "revcpu.RevCPU")
+comp_cpu.addParams(params)
+
+# EOF
@@ -0,0 +1,102 @@
+#!/bin/bash
+
+#Build the test
+make clean && make
+rm -f trace_filter.log trace_filter.all trace_filter.out
+
+# Check that the exec was built...
+if [ ! -x trace_filter.exe ]; then
+	echo "Test TRACER: trace_filter.exe not Found - likely build failed"
+	exit 1
+fi
+
+# leaf() extends to the next function
+NM=${RVCC:+${RVCC%gcc}nm}
+NM=${NM:-riscv64-unknown-elf-nm}
+lo=$($NM -n trace_filter.exe | awk '$3 == "leaf" { print $1 }')
+hi=$($NM -n trace_filter.exe | awk -v lo="$lo" 'found && ($2 == "T" || $2 == "t") && $1 != lo { print $1; exit } $3 == "leaf" { found = 1 }')
+if [ -z "$lo" ] || [ -z "$hi" ]; then
+	echo "Test TRACER: could not find leaf() in trace_filter.exe"
+	exit 1
+fi
+
+# Trace lines without the logging prefix
+run() {
+	local out
+	out=$(sst --add-lib-path=../../build/src/ ./rev-test-trace-filter.py 2>&1)
+	echo "$out" | grep -q "Simulation is complete" || { echo "$out" >&2; return 1; }
+	echo "$out" | sed -n 's/^RevCPU\[[^]]*\]: //p' | grep -E '; \*I '
+}
+
+# Unfiltered trace; the log gives the filtered runs the same thread IDs
+RECORD_LOG=trace_filter.log run > trace_filter.all || exit 1
+
+# check <filter> <argument>: trace_filter.out holds exactly the lines of
+# trace_filter.all that pass the filter
+check() {
+	python3 - "$1" "$2" "$lo" "$hi" <<'PY'
+import re, sys
+mode, arg, lo, hi = sys.argv[1], sys.argv[2], int(sys.argv[3], 16), int(sys.argv[4], 16)
+pat = re.compile(r'Core \d+; Hart (\d+); Thread (\d+); \*I 0x([0-9a-f]+):([0-9a-f]+)')
+def parse(path):
+    recs = []
+    for line in open(path):
+        m = pat.search(line)
+        recs.append((int(m.group(1)), int(m.group(2)), int(m.group(3), 16), int(m.group(4), 16), line))
+    return recs
+def branch(insn):
+    if insn & 3 == 3:
+        return insn & 0x7f in (0x63, 0x6f, 0x67)
+    op, funct3 = insn & 3, (insn >> 13) & 7
+    if op == 1:
+        return funct3 in (5, 6, 7)
+    return op == 2 and funct3 == 4 and (insn >> 7) & 0x1f != 0 and (insn >> 2) & 0x1f == 0
+def mem(line):
+    return '<-[' in line or ']<-' in line
+full, out = parse('trace_filter.all'), parse('trace_filter.out')
+key = lambda r: (r[0], r[1], r[2], r[3])
+if mode == 'symbols':
+    # the loader may end leaf() at a closer symbol than nm
+    ok = [r for r in out if not lo <= r[2] < hi] == [] and len(out) > 0
+else:
+    keep = {
+        'range':   lambda r: lo <= r[2] < hi,
+        'harts':   lambda r: r[0] == int(arg),
+        'threads': lambda r: r[1] == int(arg),
+        'branch':  lambda r: branch(r[3]),
+        'mem':     lambda r: mem(r[4]),
+    }[mode]
+    want = sorted(key(r) for r in full if keep(r))
+    ok = len(want) > 0 and sorted(key(r) for r in out) == want
+sys.exit(0 if ok else 1)
+PY
+}
+
+filter() {
+	local mode=$1 arg=$2
+	shift 2
+	( export REPLAY_LOG=trace_filter.log "$@"; run ) > trace_filter.out || exit 1
+	if ! check "$mode" "$arg"; then
+		echo "Test TRACER: the trace filtered by $mode $arg is wrong"
+		exit 1
+	fi
+}
+
+# the first thread traced is main, the other one the worker
+threads=$(sed -n 's/^Core [0-9]*; Hart \([0-9]*\); Thread \([0-9]*\);.*/\1 \2/p' trace_filter.all)
+main=$(echo "$threads" | awk 'NR == 1 { print $2 }')
+read -r hart worker <<< "$(echo "$threads" | awk -v main="$main" '$2 != main { print; exit }')"
+if [ -z "$worker" ]; then
+	echo "Test TRACER: the worker thread was not traced"
+	exit 1
+fi
+
+filter symbols leaf TRC_SYMBOLS=leaf
+filter range - TRC_RANGE="0x$lo-0x$hi"
+filter harts "$hart" TRC_HARTS="$hart"
+filter threads "$worker" TRC_THREADS="$worker"
+filter branch - TRC_CLASS=branch
+filter mem - TRC_CLASS=mem
+
+rm -f trace_filter.log trace_filter.all trace_filter.out
+echo "Simulation is complete"
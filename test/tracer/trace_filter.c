@@ -0,0 +1,58 @@
+/*
+ * trace_filter.c
+ *
+ * RISC-V ISA: RV64GC
+ *
+ * Copyright (C) 2017-2024 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ * A worker thread on the second hart and the main thread both call leaf(),
+ * which loads, stores and takes some of its branches.  run_trace_filter.sh
+ * checks the trace with each of the trace filters set.
+ */
+
+#include "syscalls.h"
+#include <stdint.h>
+
+#define assert(x)                                                              \
+  do                                                                           \
+    if (!(x)) {                                                                \
+      asm(".dword 0x00000000");                                                \
+    }                                                                          \
+  while (0)
+
+#define N 16
+
+static uint64_t data[N];
+
+uint64_t leaf(uint64_t x) {
+  uint64_t s = 0;
+  for (int i = 0; i < N; i++) {
+    if (data[i] & 1)
+      s += data[i];
+    else
+      data[i] = s;
+  }
+  return s + x;
+}
+
+void *worker(uint64_t *r) {
+  *r = leaf(1);
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  for (int i = 0; i < N; i++)
+    data[i] = i;
+
+  uint64_t r = 0;
+  rev_pthread_t t;
+  assert(rev_pthread_create(&t, NULL, (void *)worker, &r) == 0);
+  rev_pthread_join(t);
+  assert(r == 65);
+  assert(leaf(2) == 150);
+  return 0;
+}